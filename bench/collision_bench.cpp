@@ -0,0 +1,570 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  collision_bench.cpp
+ *
+ *  A headless stress test for SS_CollisionManager. It fills a
+ *  world with sprite and vector colliders laid out a few ways,
+ *  moves them, and times RunCollisionTest with each broadphase.
+ *  Sprites use real collision masks made from the images in
+ *  bench/data, which the build copies next to the program.
+ *
+ *  Usage:
+ *    SimpleSpriteCollisionBench [-n count] [-f frames]
+ *        [-d uniform|clustered|band|all] [-b bands|grid|sweep|all]
+ *        [-v vector-share] [-s seed] [-data folder]
+ *    SimpleSpriteCollisionBench -layer count [-f frames]
+ *
+ *  Results go to stderr, one line per layout and broadphase,
+ *  as per-frame averages, with the list node slabs allocated
+ *  during the run (none once the lists are warmed up).
+ *
+ *  With "-layer count" it instead fills a single layer with
+ *  that many sprites, checks that the layer holds every one,
+ *  and times filling, processing, removing every other item
+ *  and tearing it down. This is for layers far past the old
+ *  65535-item limit, where a removal that searched the list
+ *  would never finish. It also fills some groups and kills
+ *  half of their members, which the groups then dispose.
+ *
+ */
+
+#include <SimpleSprite/SimpleSprite.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//
+// Collision bits
+//
+#define BENCH_ROCK      0x01
+#define BENCH_SHIP      0x02
+#define BENCH_BULLET    0x04
+#define BENCH_WALL      0x08
+#define BENCH_VECTOR    0x10
+
+#define BENCH_SPACING   40.0f               // average room per collider, in pixels
+
+enum benchLayout {
+    BENCH_UNIFORM,                          // spread evenly over a square
+    BENCH_CLUSTERED,                        // bunched in a few hundred blobs
+    BENCH_BAND,                             // all in one collision band
+    BENCH_LAYOUTS
+};
+
+static const char *layoutNames[BENCH_LAYOUTS] = { "uniform", "clustered", "band" };
+
+static const collisionBroadphase backends[] = { SS_BROADPHASE_BANDS, SS_BROADPHASE_GRID, SS_BROADPHASE_SWEEP };
+static const char *backendNames[] = { "bands", "grid", "sweep" };
+#define BENCH_BACKENDS  3
+
+//
+// Settings from the command line
+//
+static int          benchCount      = 10000;
+static int          benchFrames     = 100;
+static int          benchLayout     = -1;           // -1 for all of them
+static int          benchBackend    = -1;
+static float        benchVectors    = 0.1f;         // share of vector colliders
+static unsigned     benchSeed       = 1;
+static const char   *benchData      = "bench-data";
+static int          benchLayerItems = 0;            // non-zero for the layer stress
+
+static inline float frand(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)((double)random() / (double)RAND_MAX);
+}
+
+//
+// Totals for one run
+//
+typedef struct {
+    Uint64          candidates, narrow, hits;
+    Uint64          nanoseconds;
+    Uint64          slabs;
+    Uint32          lag;
+} benchResult;
+
+
+#pragma mark -
+//--------------------------------------------------------------
+// BenchWorld
+//
+//  The world keeps where everything started, so each
+//  broadphase can be timed over exactly the same motion.
+//
+class BenchWorld : public SS_World
+{
+    private:
+        typedef struct {
+            float       x, y, xv, yv;
+        } benchStart;
+
+        SS_Layer                    *layer;
+        std::vector<SS_Collider*>   items;
+        std::vector<benchStart>     starts;
+        float                       worldW, worldH;
+
+    public:
+                        BenchWorld(int layout);
+
+        void            Restart();
+        void            MoveItems();
+        void            Measure(collisionBroadphase b, int frames, benchResult *result);
+
+    private:
+        void            Place(SS_Collider *item, int layout, float xv, float yv);
+};
+
+//
+// BenchWorld(layout)
+// Load the masters and fill the world with copies of them
+//
+BenchWorld::BenchWorld(int layout)
+{
+    SS_Folder::SetWorkingDir(benchData);
+
+    layer = NewLayer();
+
+    SS_Sprite *rock = new SS_Sprite(), *ship = new SS_Sprite(), *bullet = new SS_Sprite(), *wall = new SS_Sprite();
+    rock->AddFrame("rock.png", SS_COLLISION_MASK);
+    ship->AddFrame("ship.png", SS_COLLISION_MASK);
+    bullet->AddFrame("bullet.png", SS_COLLISION_MASK);
+    wall->AddFrame("wall.png", SS_COLLISION_MASK);
+
+    float side = sqrtf((float)benchCount) * BENCH_SPACING;
+    if (layout == BENCH_BAND) {
+        worldW = SS_COLLISION_BAND_SIZE;
+        worldH = side * side / SS_COLLISION_BAND_SIZE;
+    }
+    else
+        worldW = worldH = side;
+
+    int vectors = (int)(benchCount * benchVectors);
+
+    for (int i = 0; i < benchCount; i++)
+    {
+        if (i < vectors)
+        {
+            SS_VectorSprite *v = new SS_VectorSprite();
+            v->EnableCollisions(BENCH_VECTOR, BENCH_ROCK);
+            Place(v, layout, frand(-2, 2), frand(-2, 2));
+            continue;
+        }
+
+        // Of the sprites: 4 rocks, 3 ships, 2 bullets, and a wall in 10
+        SS_Sprite   *s;
+        float       angle = frand(0, 360), speed;
+
+        switch (i % 10)
+        {
+            case 0: case 1: case 2: case 3:
+                s = new SS_Sprite(*rock);
+                s->EnableCollisions(BENCH_ROCK, BENCH_SHIP | BENCH_BULLET | BENCH_VECTOR);
+                speed = frand(0, 1);
+                break;
+
+            case 4: case 5: case 6:
+                s = new SS_Sprite(*ship);
+                s->EnableCollisions(BENCH_SHIP, BENCH_ROCK | BENCH_WALL);
+                speed = frand(1, 3);
+                break;
+
+            case 7: case 8:
+                s = new SS_Sprite(*bullet);
+                s->EnableCollisions(BENCH_BULLET, BENCH_ROCK | BENCH_WALL);
+                s->SetContinuous(true);
+                speed = 12;
+                break;
+
+            default:
+                s = new SS_Sprite(*wall);
+                s->EnableCollisions(BENCH_WALL, BENCH_SHIP | BENCH_BULLET);
+                speed = 0;
+                break;
+        }
+
+        s->SetRotation(angle);
+        Place(s, layout, SS_Game::Sin(SS_ROTINDEX(angle)) * speed, -SS_Game::Cos(SS_ROTINDEX(angle)) * speed);
+    }
+
+    // The copies keep the frames
+    delete rock;
+    delete ship;
+    delete bullet;
+    delete wall;
+}
+
+//
+// Place(item, layout, xvel, yvel)
+//
+void BenchWorld::Place(SS_Collider *item, int layout, float xv, float yv)
+{
+    benchStart  st;
+
+    if (layout == BENCH_CLUSTERED)
+    {
+        // A blob per thousand, roughly bell-shaped
+        int     blobs = MAX(1, benchCount / 1000), b = (int)items.size() % blobs;
+        float   cx = (b * 7919 % 1000) / 1000.0f * worldW, cy = (b * 104729 % 1000) / 1000.0f * worldH;
+        float   r = BENCH_SPACING * 6;
+
+        st.x = cx + (frand(-1, 1) + frand(-1, 1) + frand(-1, 1)) * r;
+        st.y = cy + (frand(-1, 1) + frand(-1, 1) + frand(-1, 1)) * r;
+    }
+    else
+    {
+        st.x = frand(0, worldW);
+        st.y = frand(0, worldH);
+    }
+
+    st.xv = xv;
+    st.yv = yv;
+
+    item->Move(st.x, st.y);
+    item->SetVelocity(xv, yv);
+    layer->AddItem(item);
+
+    items.push_back(item);
+    starts.push_back(st);
+}
+
+//
+// Restart
+// Put everything back where it began
+//
+void BenchWorld::Restart()
+{
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        items[i]->Move(starts[i].x, starts[i].y);
+        items[i]->SetVelocity(starts[i].xv, starts[i].yv);
+        items[i]->UpdateNodePosition();
+        items[i]->ResetSweep();
+    }
+}
+
+//
+// MoveItems
+// One step of motion, bouncing off the edges of the world
+//
+void BenchWorld::MoveItems()
+{
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        SS_Collider *item = items[i];
+
+        item->ApplyMotion();
+
+        if ( (item->xpos < 0 && item->xvel < 0) || (item->xpos > worldW && item->xvel > 0) )
+            item->xvel *= -1;
+
+        if ( (item->ypos < 0 && item->yvel < 0) || (item->ypos > worldH && item->yvel > 0) )
+            item->yvel *= -1;
+
+        item->UpdateNodePosition();
+    }
+}
+
+//
+// Measure(broadphase, frames, &result)
+//
+//  Time the collision test alone over a run of frames. The
+//  first frame settles the lists and the contacts left by
+//  the last broadphase, and isn't counted.
+//
+void BenchWorld::Measure(collisionBroadphase b, int frames, benchResult *result)
+{
+    memset(result, 0, sizeof(*result));
+
+    SetCollisionBudget(0);
+    SetBroadphase(b);
+    Restart();
+    RunCollisionTest();
+
+    Uint64 slabs = SS_NodePool::Stats().slabs;
+
+    for (int f = 0; f < frames; f++)
+    {
+        MoveItems();
+
+        Uint64 t = SS_Profiler::Now();
+        RunCollisionTest();
+        result->nanoseconds += SS_Profiler::Now() - t;
+
+        const SS_CollisionStats &st = CollisionStats();
+        result->candidates += st.candidates;
+        result->narrow += st.narrow;
+        result->hits += st.hits;
+    }
+
+    result->slabs = SS_NodePool::Stats().slabs - slabs;
+    result->lag = CollisionLag();
+}
+
+
+#pragma mark -
+//--------------------------------------------------------------
+// BenchGame
+//
+class BenchGame : public SS_Game
+{
+    public:
+        void            Run() override;
+
+    private:
+        void            StressLayer();
+        void            CheckLayer(SS_Layer *layer, int count);
+        void            StressGroups(SS_Layer *layer, SS_Sprite *master);
+};
+
+//
+// Run
+// Each layout, then each broadphase within it
+//
+void BenchGame::Run()
+{
+    if (benchLayerItems)
+    {
+        StressLayer();
+        return;
+    }
+
+    fprintf(stderr, "%d colliders (%d%% vector), %d frames, %d worker threads\n\n",
+            benchCount, (int)(benchVectors * 100), benchFrames, SS_WorkerPool::Shared()->ThreadCount());
+    fprintf(stderr, "%-10s %-6s %14s %12s %10s %14s %8s\n", "layout", "phase", "candidates", "narrow", "hits", "ns/frame", "slabs");
+
+    for (int l = 0; l < BENCH_LAYOUTS; l++)
+    {
+        if (benchLayout >= 0 && l != benchLayout)
+            continue;
+
+        srandom(benchSeed);
+        BenchWorld *bench = new BenchWorld(l);
+        SetWorld(bench);
+
+        for (int b = 0; b < BENCH_BACKENDS; b++)
+        {
+            if (benchBackend >= 0 && b != benchBackend)
+                continue;
+
+            benchResult r;
+            bench->Measure(backends[b], benchFrames, &r);
+
+            fprintf(stderr, "%-10s %-6s %14.0f %12.0f %10.0f %14.0f %8llu\n", layoutNames[l], backendNames[b],
+                    (double)r.candidates / benchFrames, (double)r.narrow / benchFrames,
+                    (double)r.hits / benchFrames, (double)r.nanoseconds / benchFrames,
+                    (unsigned long long)r.slabs);
+        }
+
+        SetWorld(nullptr);
+        delete bench;
+    }
+}
+
+//
+// StressLayer
+//
+//  Fill one layer with copies of a sprite, make sure the
+//  count and the list agree, then run the layer a few times
+//  and remove half of it. A count that wrapped would show
+//  up here as a mismatch.
+//
+void BenchGame::StressLayer()
+{
+    int     count = benchLayerItems, frames = MIN(benchFrames, 10);
+
+    fprintf(stderr, "Layer stress: %d items, %d frames\n\n", count, frames);
+
+    SS_Folder::SetWorkingDir(benchData);
+
+    SS_World *world = new SS_World();
+    SetWorld(world);
+    SS_Layer *layer = world->NewLayer();
+
+    SS_Sprite *rock = new SS_Sprite();
+    rock->AddFrame("rock.png");
+
+    srandom(benchSeed);
+    float side = sqrtf((float)count) * BENCH_SPACING;
+
+    std::vector<SS_Sprite*> sprites(count);
+
+    Uint64 t = SS_Profiler::Now();
+    for (int i = 0; i < count; i++)
+    {
+        SS_Sprite *s = sprites[i] = new SS_Sprite(*rock);
+        s->Move(frand(0, side), frand(0, side));
+        s->SetVelocity(frand(-1, 1), frand(-1, 1));
+        layer->AddItem(s);
+    }
+    Uint64 fill = SS_Profiler::Now() - t;
+
+    CheckLayer(layer, count);
+
+    t = SS_Profiler::Now();
+    for (int f = 0; f < frames; f++)
+        layer->Process();
+    Uint64 process = SS_Profiler::Now() - t;
+
+    // Every other item, each found by its own node
+    int removed = count / 2;
+
+    t = SS_Profiler::Now();
+    for (int i = 0; i < removed; i++)
+        layer->RemoveItem(sprites[i * 2 + 1]);
+    Uint64 remove = SS_Profiler::Now() - t;
+
+    CheckLayer(layer, count - removed);
+
+    StressGroups(layer, rock);
+
+    // The copies keep the frame
+    delete rock;
+
+    t = SS_Profiler::Now();
+    SetWorld(nullptr);
+    delete world;
+    Uint64 teardown = SS_Profiler::Now() - t;
+
+    fprintf(stderr, "fill %.0f ns/item, process %.0f ns/item, remove %.0f ns/item, teardown %.0f ns/item\n",
+            (double)fill / count, (double)process / ((double)count * frames),
+            (double)remove / MAX(1, removed), (double)teardown / count);
+
+    SS_NodeStats st = SS_NodePool::Stats();
+    fprintf(stderr, "list nodes: %llu allocs, %llu live, %llu peak, %llu slabs (%.1f MB)\n",
+            (unsigned long long)st.allocs, (unsigned long long)st.live, (unsigned long long)st.peak,
+            (unsigned long long)st.slabs, st.bytes / 1048576.0);
+}
+
+//
+// CheckLayer(layer, count)
+// The count and a walk of the list should both match
+//
+void BenchGame::CheckLayer(SS_Layer *layer, int count)
+{
+    Uint32          walked = 0;
+    SS_ItemIterator itr = layer->GetIterator();
+    while (itr.NextItem())
+        walked++;
+
+    fprintf(stderr, "Size() %u, walked %u\n", layer->Size(), walked);
+
+    if (layer->Size() != (Uint32)count || walked != (Uint32)count)
+    {
+        fprintf(stderr, "Layer lost items\n");
+        exit(1);
+    }
+}
+
+//
+// StressGroups(layer, master)
+//
+//  Fill a hundred groups with copies of the master, kill
+//  every other member, and let each group dispose of them.
+//
+void BenchGame::StressGroups(SS_Layer *layer, SS_Sprite *master)
+{
+    const int   groups = 100, members = 100;
+    SS_ItemGroup *group[groups];
+
+    for (int g = 0; g < groups; g++)
+    {
+        group[g] = new SS_ItemGroup();
+        layer->AddItem(group[g]);
+
+        for (int i = 0; i < members; i++)
+            group[g]->AddItem(new SS_Sprite(*master));
+    }
+
+    Uint64 live = SS_NodePool::Stats().live;
+
+    for (int g = 0; g < groups; g++)
+    {
+        int i = 0;
+        SS_Collider         *item;
+        SS_ColliderIterator itr = group[g]->GetIterator();
+        while ((item = itr.NextItem()))
+            if (i++ & 1) item->Kill();
+
+        group[g]->Process();
+    }
+
+    Uint32 left = 0;
+    for (int g = 0; g < groups; g++)
+        left += group[g]->Size();
+
+    Uint64 freed = live - SS_NodePool::Stats().live;
+
+    fprintf(stderr, "groups: %u of %d members left, %llu nodes freed\n",
+            left, groups * members, (unsigned long long)freed);
+
+    if (left != (Uint32)(groups * members / 2) || freed != (Uint64)(groups * members / 2))
+    {
+        fprintf(stderr, "Group disposal went wrong\n");
+        exit(1);
+    }
+}
+
+
+#pragma mark -
+//
+// Command line
+//
+static int name_index(const char *name, const char **names, int count)
+{
+    if (!strcmp(name, "all"))
+        return -1;
+
+    for (int i = 0; i < count; i++)
+        if (!strcmp(name, names[i]))
+            return i;
+
+    fprintf(stderr, "Unknown choice \"%s\"\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char *opt = argv[i], *val = argv[i + 1];
+
+        if (!strcmp(opt, "-n"))             benchCount = MAX(1, atoi(val));
+        else if (!strcmp(opt, "-f"))        benchFrames = MAX(1, atoi(val));
+        else if (!strcmp(opt, "-d"))        benchLayout = name_index(val, layoutNames, BENCH_LAYOUTS);
+        else if (!strcmp(opt, "-b"))        benchBackend = name_index(val, backendNames, BENCH_BACKENDS);
+        else if (!strcmp(opt, "-v"))        benchVectors = MIN(1.0f, MAX(0.0f, (float)atof(val)));
+        else if (!strcmp(opt, "-s"))        benchSeed = (unsigned)atoi(val);
+        else if (!strcmp(opt, "-data"))     benchData = val;
+        else if (!strcmp(opt, "-layer"))    benchLayerItems = MAX(1, atoi(val));
+        else {
+            fprintf(stderr, "Unknown option %s\n", opt);
+            return 1;
+        }
+    }
+
+    // No window, GL context or audio
+    setenv("SS_HEADLESS", "1", 1);
+
+    BenchGame *game = nullptr;
+
+    try
+    {
+        game = new BenchGame();
+        game->Run();
+    }
+    catch (const char* err)
+    {
+        fprintf(stderr, err, SDL_GetError());
+        fprintf(stderr, "\n");
+    }
+
+    delete game;
+
+    return 0;
+}
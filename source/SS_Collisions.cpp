@@ -13,229 +13,1798 @@
 #include "SS_Game.h"
 #include "SS_ItemGroup.h"
 #include "SS_World.h"
+#include "SS_Workers.h"
 
+#include <float.h>
+#include <string.h>
+#include <vector>
+
+//--------------------------------------------------------------
+//
+//  Collision tests are scheduled a band or grid bucket at a
+//  time, within a budget of microseconds per test (see
+//  SetCollisionBudget). Units holding a fast mover go first,
+//  then the rest in turn from wherever the last test left
+//  off. A quiet scene gets every unit tested every frame; a
+//  crowded one takes a few frames to get around, and
+//  CollisionLag says how many.
+//
+//--------------------------------------------------------------
+
+#define SPATIAL_INDEX(x)    ( ((x) < 0) \
+                            ? (SS_COLLISION_LISTS - 1) - (Uint16)floorf(-(x) / SS_COLLISION_BAND_SIZE) % SS_COLLISION_LISTS \
+                            : (Uint16)floorf((x) / SS_COLLISION_BAND_SIZE) % SS_COLLISION_LISTS )
+
+
+//--------------------------------------------------------------
+//
+// SS_CollisionManager
+//
+//  Manages colliders in an optimal manner, dividing them up into
+//  linked lists based on collision id and physical position.
+//
+//  This is implemented as linked lists so the nodes may be
+//  scattered and non-optimal for caching, so reducing tests is
+//  important. Lists are likely to change often, but may still
+//  be optimizable by implementing using self-sizing arrays.
+//
 //--------------------------------------------------------------
+
+
+SS_CollisionManager::SS_CollisionManager()
+{
+    Init();
+}
+
+//
+// ~SS_CollisionManager
+//
+//  The world disposes its layers (and so its colliders)
+//  before this runs, so the grid buckets should be empty.
+//
+SS_CollisionManager::~SS_CollisionManager()
+{
+    delete [] cellList;
+}
+
+void SS_CollisionManager::Init()
+{
+    cellList    = nullptr;
+    broadphase  = SS_BROADPHASE_BANDS;
+    cellSize    = SS_COLLISION_CELL_SIZE;
+
+    memset(classCount, 0, sizeof(classCount));
+    memset(bitCount, 0, sizeof(bitCount));
+    memset(classOut, 0, sizeof(classOut));
+    memset(classIn, 0, sizeof(classIn));
+    memset(classPairs, 0, sizeof(classPairs));
+    pairsChanged = false;
+
+    contactGeneration = 0;
+    nextColliderID = 1;
+    memset(&collisionStats, 0, sizeof(collisionStats));
+
+    collisionBudget = SS_COLLISION_BUDGET;
+    collisionLag    = 1;
+    pendingUnits    = 0;
+    scheduleCursor  = 0;
+    cycleStart      = 0;
+    hotEpoch        = 1;
+
+    for (int j=0; j < SS_COLLISION_CLASSES; j++)
+        for (int i=0; i < SS_COLLISION_LISTS; i++)
+            colliderList[j][i].Clear();
+}
+
+//
+//  Collision lists represent swaths of space of a given
+//  width and infinite height. So if you use 200 lists
+//  with each representing a 512 pixel-wide swath, the
+//  list encompasses all colliders in each 102,400 pixel-
+//  wide region of the world in a single model. Every
+//  item in each list will either be very close to each
+//  other or very far away. In this arrangement it is only
+//  necessary to test collisions between an item and the
+//  items which follow it in its own list, and only its
+//  right neighboring collision list.
+//
+//  The side-effect of this scheme is that the collision
+//  lists need to be dynamic. Items need to be moved to the
+//  appropriate collision list in response to motion in the
+//  world. (TODO: Allow custom rules for placement?)
+//
+//  Each band is further split by collision class, the
+//  lowest bit an item generates (see CollisionClass).
+//  A table of which classes can ever collide is kept up
+//  to date as colliders come and go, and only lists of
+//  classes that pair are tested against each other. So
+//  bullets that only hit ships are never tested against
+//  other bullets at all.
+//
+
+//
+//  The grid broadphase instead divides space into square
+//  cells, hashed into a fixed set of buckets so the world
+//  needn't have edges. Items are tested against others in
+//  the same cell and in four of the eight neighbors, so
+//  each neighboring pair of cells is visited once. Sparse
+//  worlds with tall columns of items do much better this
+//  way than with bands, which test every pair in a column.
+//
+//  The sweep broadphase keeps every collider in one array
+//  sorted on the left edge of its bounding box. The order
+//  is kept from frame to frame, so an insertion sort puts
+//  it right again in close to linear time, and only items
+//  whose boxes overlap on both axes are tested.
+//
+
+//
+// SetBroadphase(broadphase, cellSize)
+//
+//  Choose bands or the grid, and the grid's cell size.
+//  Colliders already in the world are moved over.
+//
+void SS_CollisionManager::SetBroadphase(collisionBroadphase b, float size)
+{
+    DEBUGF(1, "[%p] SS_CollisionManager::SetBroadphase(%d, %.1f)\n", this, b, size);
+
+    std::vector<SS_Collider*>   all;
+    SS_Collider                 *item;
+
+    for (int i=0; i < ListCount(); i++)
+    {
+        SS_ColliderIterator itr = ListAt(i)->GetIterator();
+        while ((item = itr.NextItem())) {
+            item->sweepIndex = -1;
+            all.push_back(item);
+        }
+    }
+
+    sweepOrder.clear();
+
+    if (b == SS_BROADPHASE_GRID && !cellList)
+        cellList = new SS_ColliderList[SS_COLLISION_CELLS];
+
+    if (size > 0)
+        cellSize = size;
+
+    broadphase = b;
+
+    for (size_t i=0; i < all.size(); i++)
+    {
+        all[i]->listNumber = -1;
+        PlaceCollider(all[i]);
+    }
+}
+
+//
+// ListCount
+// How many lists the current broadphase uses
+//
+int SS_CollisionManager::ListCount() const
+{
+    switch (broadphase)
+    {
+        case SS_BROADPHASE_GRID:    return SS_COLLISION_CELLS + 1;
+        case SS_BROADPHASE_SWEEP:   return 1;
+        default:                    return SS_COLLISION_CLASSES * SS_COLLISION_LISTS + 1;
+    }
+}
+
+//
+// ListAt(index)
+//
+SS_ColliderList* SS_CollisionManager::ListAt(int i)
+{
+    if (i == LargeIndex())
+        return &largeList;
+
+    switch (broadphase)
+    {
+        case SS_BROADPHASE_GRID:    return &cellList[i];
+        case SS_BROADPHASE_SWEEP:   return &sweepList;
+        default:                    return &colliderList[0][0] + i;
+    }
+}
+
+//
+// LargeIndex
+// The large list comes after the rest, except when sweeping
+//
+int SS_CollisionManager::LargeIndex() const
+{
+    return (broadphase == SS_BROADPHASE_SWEEP) ? -2 : ListCount() - 1;
+}
+
+//
+// ListIndexOf(item)
+//
+//  The list for an item where it is now. Pair tests only
+//  look one band or cell over, so an item whose box is
+//  wider (or with the grid, taller) than that goes in the
+//  large list instead, to be tested against whatever its
+//  box covers. Anything bigger than a band either way is
+//  also marked oversize, as the distance cut in the pair
+//  tests would miss some of its hits.
+//
+int SS_CollisionManager::ListIndexOf(SS_Collider *item)
+{
+    SS_Point    pos;
+    float       l, t, r, b;
+
+    item->GlobalPosition(&pos);
+    item->CollisionBounds(&l, &t, &r, &b);
+
+    bool    grid = (broadphase == SS_BROADPHASE_GRID);
+    float   size = grid ? cellSize : (float)SS_COLLISION_BAND_SIZE;
+    int     i = ListIndexFor(pos.x, pos.y, item->collClass, &item->cellX, &item->cellY);
+
+    item->oversize = (r - l > SS_COLLISION_BAND_SIZE || b - t > SS_COLLISION_BAND_SIZE);
+
+    if ( broadphase != SS_BROADPHASE_SWEEP && (r - l > size || (grid && b - t > size)) )
+        return LargeIndex();
+
+    return i;
+}
+
+//
+// ListIndexFor(x, y, class, &cellX, &cellY)
+// The list for a point and class, and the band or cell it's in
+//
+int SS_CollisionManager::ListIndexFor(float x, float y, Uint8 cls, Sint32 *cx, Sint32 *cy)
+{
+    if (broadphase == SS_BROADPHASE_GRID)
+    {
+        *cx = (Sint32)floorf(x / cellSize);
+        *cy = (Sint32)floorf(y / cellSize);
+        return CellIndex(*cx, *cy, cls);
+    }
+
+    if (broadphase == SS_BROADPHASE_SWEEP)
+    {
+        *cx = *cy = 0;
+        return 0;
+    }
+
+    *cx = SPATIAL_INDEX(x);
+    *cy = 0;
+    return cls * SS_COLLISION_LISTS + *cx;
+}
+
+//
+// AddToColliders
+// Add a layeritem to the collision pool
 //
-//  COLLISION_SLEW indicates the fraction of the lists which
-//  will be collision-tested per frame. Larger slew values may
-//  increase frame rates slightly but also will reduce the
-//  frequency of tests. Fine tune for your own situation.
+
+SS_ColliderNode* SS_CollisionManager::AddToColliders(SS_Collider *item)
+{
+    if (item->Layer() && item->World())
+    {
+        item->collClass = CollisionClass(item->collisionOut);
+        item->collManager = this;
+        item->colliderID = nextColliderID++;
+        if (!nextColliderID) nextColliderID = 1;
+        CountMasks(item, 1);
+
+        item->listNumber = ListIndexOf(item);
+
+        SS_ColliderNode *node = ListAt(item->listNumber)->Append(item);
+        if (broadphase == SS_BROADPHASE_SWEEP)
+            SweepInsert(item);
+
+        if (item->continuous)
+            AddContinuous(item);
+
+        return node;
+    }
+    else
+        return nullptr;
+}
+
+//
+// RemoveCollider(item)
+// Take a collider out of its list and the pair table
+//
+void SS_CollisionManager::RemoveCollider(SS_Collider *item)
+{
+    item->collNode->RemoveSelf();
+    CountMasks(item, -1);
+    DropContacts(item);
+    item->colliderID = 0;
+
+    if (item->continuous)
+        RemoveContinuous(item);
+
+    // Leave a gap for the next sort to close
+    if (item->sweepIndex >= 0) {
+        sweepOrder[item->sweepIndex] = nullptr;
+        item->sweepIndex = -1;
+    }
+
+    item->collManager = nullptr;
+}
+
+//
+// PlaceCollider(item)
+// Move a collider to the list for where it is now
+//
+void SS_CollisionManager::PlaceCollider(SS_Collider *item)
+{
+    int i = ListIndexOf(item);
+    if (item->listNumber != i) {
+        item->collNode->Migrate(ListAt(i));
+        item->listNumber = i;
+    }
+
+    if (broadphase == SS_BROADPHASE_SWEEP && item->sweepIndex < 0)
+        SweepInsert(item);
+
+    MarkFastMover(item);
+}
+
+//
+// SweepInsert(item)
+// Add an item to the end of the sweep order
+//
+void SS_CollisionManager::SweepInsert(SS_Collider *item)
+{
+    item->CollisionBounds(&item->boxLeft, &item->boxTop, &item->boxRight, &item->boxBottom);
+    item->sweepIndex = (Sint32)sweepOrder.size();
+    sweepOrder.push_back(item);
+}
+
+//
+// SweepSort
+//
+//  Refresh every box, close the gaps left by removed items,
+//  and insertion sort on the left edges. Most items keep
+//  their places from one frame to the next, so this hardly
+//  moves anything.
+//
+void SS_CollisionManager::SweepSort()
+{
+    size_t n = 0;
+
+    for (size_t i=0; i < sweepOrder.size(); i++)
+    {
+        SS_Collider *item = sweepOrder[i];
+        if (!item)
+            continue;
+
+        item->CollisionBounds(&item->boxLeft, &item->boxTop, &item->boxRight, &item->boxBottom);
+
+        size_t j = n++;
+        while (j > 0 && sweepOrder[j-1]->boxLeft > item->boxLeft)
+        {
+            sweepOrder[j] = sweepOrder[j-1];
+            sweepOrder[j]->sweepIndex = (Sint32)j;
+            j--;
+        }
+
+        sweepOrder[j] = item;
+        item->sweepIndex = (Sint32)j;
+    }
+
+    sweepOrder.resize(n);
+}
+
+//
+// CollisionClass(out)
+// The class for a collider generating these bits
+//
+Uint8 SS_CollisionManager::CollisionClass(Uint32 out)
+{
+    if (out == 0)
+        return SS_COLLISION_RECEIVER;
+
+    Uint8 c = 0;
+    while (!(out & 1)) {
+        out >>= 1;
+        c++;
+    }
+
+    return c;
+}
+
+//
+// CountMasks(item, delta)
+//
+//  Count an item's out and in bits in or out of its class.
+//  The pair table only needs building again when a class
+//  gains its first user of a bit or loses its last.
+//
+void SS_CollisionManager::CountMasks(SS_Collider *item, int delta)
+{
+    Uint8   c = item->collClass;
+    Uint32  masks[2] = { item->collisionOut, item->collisionIn };
+
+    classCount[c] += delta;
+
+    for (int k=0; k<2; k++)
+        for (int b=0; b<32; b++)
+            if (masks[k] & (1U << b))
+            {
+                Uint32 &n = bitCount[c][k][b];
+                if (delta > 0 ? n++ == 0 : --n == 0)
+                    pairsChanged = true;
+            }
+}
+
+//
+// UpdatePairs
+//
+//  Two classes pair when something in each generates what
+//  something in the other receives. This is looser than
+//  CanCollide, which still decides for each pair of items.
+//
+void SS_CollisionManager::UpdatePairs()
+{
+    if (!pairsChanged)
+        return;
+
+    pairsChanged = false;
+
+    for (int c=0; c < SS_COLLISION_CLASSES; c++)
+    {
+        classOut[c] = classIn[c] = 0;
+        for (int b=0; b<32; b++)
+        {
+            if (bitCount[c][0][b]) classOut[c] |= 1U << b;
+            if (bitCount[c][1][b]) classIn[c] |= 1U << b;
+        }
+    }
+
+    for (int a=0; a < SS_COLLISION_CLASSES; a++)
+    {
+        classPairs[a] = 0;
+        for (int b=0; b < SS_COLLISION_CLASSES; b++)
+            if ((classOut[a] & classIn[b]) && (classIn[a] & classOut[b]))
+                classPairs[a] |= 1ULL << b;
+    }
+}
+
+//
+// ClassesPair(a, b)
+// Can items of these two classes ever collide?
+//
+bool SS_CollisionManager::ClassesPair(Uint8 a, Uint8 b)
+{
+    UpdatePairs();
+    return ((classPairs[a] >> b) & 1) != 0;
+}
+
+//
+// TestList(item, iterator, cellX, cellY, class)
+//
+//  Test an item against the rest of a list, both ways. Grid
+//  buckets can hold other cells and classes, which are skipped.
+//
+void SS_CollisionManager::TestList(SS_Collider *item, SS_ColliderIterator iter, Sint32 cx, Sint32 cy, Uint8 cls, SS_PairList *out)
+{
+    SS_Collider *inner;
+    bool        grid = (broadphase == SS_BROADPHASE_GRID);
+
+    while ((inner = iter.NextItem()))
+        if ( !grid || (inner->cellX == cx && inner->cellY == cy && inner->collClass == cls) )
+            TestPair(item, inner, out);
+}
+
+//
+// SS_World::RunCollisionTest
+// Test all the sprite collisions in the world
+//
+
+//
+// Optimization Notes (TODO:)
+//
+//  The current model is a single self-migrating multi-list
+//  that moves nodes from list to list based on their spatial
+//  (x) position.
+//  Node propagation is clean and efficient as possible -
+//  implemented at the linked list template class level.
+//  However, it is currently implemented by SS_LayerItem
+//  rather than SS_CollisionManager
+//
+//  Node propagation won't need to change much, except to
+//  move node propagation to an encapsulating class.
+//
+//  Lists are now also broken into discrete groups based
+//  on the collision id (collisionOut) of their members,
+//  and RunCollisionTest only tests each item against the
+//  lists of classes which can collide with it, and which
+//  are also in its spatial sphere. As with the spatial
+//  lists, colliders don't check lower-numbered classes.
+//
+//  The Generate / Receive table is kept by CountMasks
+//  and UpdatePairs, with all unique pairs represented.
+//
+//  Bands and grid buckets are tested as units under a time
+//  budget (RunScheduled), so a crowded world spreads one
+//  full pass over several tests instead of stalling.
+//
+//
+//  layerItem->SetCollisionOut(COLL_SHIP);  // add this item to the COLL_SHIP collision-group (and remember the node)
+//  layerItem->SetCollisionIn(COLL_ROCK);   // append COLL_ROCK to its node's list of groups to test
+//  layerItem->ClearCollisionIn(COLL_ROCK); // remove COLL_ROCK from its node's list of groups to test
+//  layerItem->ClearCollisionOut();         // remove this item from its collision-group (and forget the node)
+//
+//
+void SS_CollisionManager::RunCollisionTest()
+{
+    contactGeneration++;
+    memset(&collisionStats, 0, sizeof(collisionStats));
+
+    UpdatePairs();
+
+    if (broadphase == SS_BROADPHASE_SWEEP)
+    {
+        RunSweepTest();
+        collisionLag = 1;
+        pendingUnits = 0;
+    }
+    else
+    {
+        RunScheduled();
+        TestLarge();
+    }
+
+    RunContinuousTest();
+
+    DispatchContacts();
+}
+
+//
+// TestBand(band, out)
+// Test the items in one band, by class
+//
+void SS_CollisionManager::TestBand(unsigned i, SS_PairList *out)
+{
+    SS_Collider         *item;
+    SS_ColliderIterator outer_iter;
+
+    unsigned next = (i + 1) % SS_COLLISION_LISTS,
+             prev = (i + SS_COLLISION_LISTS - 1) % SS_COLLISION_LISTS;
+
+    for ( Uint8 a = 0; a < SS_COLLISION_CLASSES; a++ )
+    {
+        Uint64 pairs = classPairs[a];
+        if ( classCount[a] == 0 || pairs == 0 || colliderList[a][i].m_count == 0 )
+            continue;
+
+        outer_iter = colliderList[a][i].GetIterator();
+
+        while ((item = outer_iter.NextItem()))
+        {
+            if ( !item->IsVisible() )
+                continue;
+
+            // Test all items following in the same list,
+            // and all items in the list to the right
+            if ( (pairs >> a) & 1 )
+            {
+                TestList(item, outer_iter, 0, 0, a, out);
+                TestList(item, colliderList[a][next].GetIterator(), 0, 0, a, out);
+            }
+
+            // Test higher classes in this band and both neighbors
+            for ( Uint8 b = a + 1; b < SS_COLLISION_CLASSES; b++ )
+            {
+                if ( classCount[b] == 0 || !((pairs >> b) & 1) )
+                    continue;
+
+                TestList(item, colliderList[b][prev].GetIterator(), 0, 0, b, out);
+                TestList(item, colliderList[b][i].GetIterator(), 0, 0, b, out);
+                TestList(item, colliderList[b][next].GetIterator(), 0, 0, b, out);
+            }
+        }
+    }
+}
+
+//
+// UnitCount
+// How many units the scheduler divides the lists into
+//
+unsigned SS_CollisionManager::UnitCount() const
+{
+    switch (broadphase)
+    {
+        case SS_BROADPHASE_GRID:    return SS_COLLISION_CELLS;
+        case SS_BROADPHASE_SWEEP:   return 1;
+        default:                    return SS_COLLISION_LISTS;
+    }
+}
+
+//
+// UnitOf(item)
+// The band or bucket an item is tested from
+//
+unsigned SS_CollisionManager::UnitOf(SS_Collider *item) const
+{
+    switch (broadphase)
+    {
+        case SS_BROADPHASE_GRID:    return item->listNumber;
+        case SS_BROADPHASE_SWEEP:   return 0;
+        default:                    return item->cellX;
+    }
+}
+
+//
+// UnitIsEmpty(unit)
+//
+bool SS_CollisionManager::UnitIsEmpty(unsigned u) const
+{
+    if (broadphase == SS_BROADPHASE_GRID)
+        return cellList[u].m_count == 0;
+
+    for ( int c = 0; c < SS_COLLISION_CLASSES; c++ )
+        if ( colliderList[c][u].m_count )
+            return false;
+
+    return true;
+}
+
+//
+// TestUnit(unit, out)
+//
+//  Test one band or bucket. With an out list the pairs are
+//  only gathered, to be applied later on the main thread.
+//
+void SS_CollisionManager::TestUnit(unsigned u, SS_PairList *out)
+{
+    if (broadphase == SS_BROADPHASE_GRID)
+        TestBucket(u, out);
+    else
+        TestBand(u, out);
+}
+
+//
+// TestBatchUnit(manager, index)
+// Worker job for one unit of a batch
+//
+void SS_CollisionManager::TestBatchUnit(void *data, Uint32 index)
+{
+    SS_CollisionManager *cm = (SS_CollisionManager*)data;
+    cm->TestUnit(cm->batchUnits[index], &cm->batchPairs[index]);
+}
+
+//
+// TestBatch
+//
+//  Test the batched units across the worker pool. Workers
+//  only read the lists, the contacts, and the frame masks,
+//  and each unit writes to its own pair list, so neighboring
+//  units can run together. The lists are then applied in
+//  batch order, the same order a single thread would have
+//  used, so contacts come out the same however the units
+//  were spread over the threads.
+//
+void SS_CollisionManager::TestBatch()
+{
+    Uint32 n = (Uint32)batchUnits.size();
+
+    if (n == 1)
+    {
+        TestUnit(batchUnits[0], nullptr);
+        MarkBucket(batchUnits[0]);
+        return;
+    }
+
+    if (batchPairs.size() < n)
+        batchPairs.resize(n);
+
+    for (Uint32 k = 0; k < n; k++)
+        batchPairs[k].clear();
+
+    SS_WorkerPool::Shared()->Run(n, TestBatchUnit, this);
+
+    for (Uint32 k = 0; k < n; k++)
+    {
+        SS_PairList &pairs = batchPairs[k];
+        for (size_t p = 0; p < pairs.size(); p++)
+            ApplyPair(pairs[p]);
+
+        MarkBucket(batchUnits[k]);
+    }
+}
+
+//
+// MarkBucket(unit)
+//
+//  On the main thread, mark the visible items of a tested
+//  grid bucket updated, even those with no one to test, so
+//  a lone item's ignored collisions are still cleared.
+//
+void SS_CollisionManager::MarkBucket(unsigned u)
+{
+    if (broadphase != SS_BROADPHASE_GRID)
+        return;
+
+    SS_Collider         *item;
+    SS_ColliderIterator iter = cellList[u].GetIterator();
+
+    while ((item = iter.NextItem()))
+        if ( item->IsVisible() )
+            item->collisionUpdated = true;
+}
+
+//
+// MarkFastMover(item)
+// Have the item's unit tested first next time
+//
+void SS_CollisionManager::MarkFastMover(SS_Collider *item)
+{
+    if (broadphase == SS_BROADPHASE_SWEEP || IsLarge(item) || item->VelocitySquared() < SS_COLLISION_FAST * SS_COLLISION_FAST)
+        return;
+
+    unsigned u = UnitOf(item);
+    if (u < hotMark.size() && hotMark[u] != hotEpoch) {
+        hotMark[u] = hotEpoch;
+        hotUnits.push_back(u);
+    }
+}
+
+//
+// RunScheduled
+//
+//  Test units until the budget runs out: first any holding
+//  fast movers, then the rest in turn. At least one unit
+//  with something in it is tested every time, so the scan
+//  always moves forward.
+//
+//  Units go out in batches, one or two per pool thread, and
+//  the budget is checked between batches. With no helper
+//  threads each batch is a single unit.
+//
+void SS_CollisionManager::RunScheduled()
+{
+    unsigned units = UnitCount();
+    if (unitTested.size() != units)
+    {
+        unitTested.assign(units, 0);
+        hotMark.assign(units, 0);
+        hotUnits.clear();
+        scheduleCursor = 0;
+        cycleStart = contactGeneration;
+    }
+
+    int         threads = SS_WorkerPool::Shared()->ThreadCount();
+    size_t      batch = threads ? (threads + 1) * 2 : 1;
+    Uint64      start = SS_Profiler::Now();
+    bool        tested = false;
+    size_t      hot = 0;
+    unsigned    visited = 0;
+
+    while ( !(collisionBudget && tested && SS_Profiler::Since(start) >= collisionBudget) )
+    {
+        batchUnits.clear();
+
+        while (batchUnits.size() < batch)
+        {
+            unsigned u;
+
+            // Fast movers first
+            if (hot < hotUnits.size())
+                u = hotUnits[hot++];
+
+            // Then pick up where the last test left off
+            else if (visited < units)
+            {
+                u = scheduleCursor;
+                visited++;
+
+                if (++scheduleCursor == units)
+                {
+                    scheduleCursor = 0;
+
+                    Uint32 lag = contactGeneration - cycleStart + 1;
+                    if (lag != collisionLag)
+                        DEBUGF(1, "[%p] SS_CollisionManager: collision lag %u tests\n", this, lag);
+
+                    collisionLag = lag;
+                    cycleStart = contactGeneration + 1;
+                }
+            }
+            else
+                break;
+
+            if (unitTested[u] != contactGeneration && !UnitIsEmpty(u))
+            {
+                unitTested[u] = contactGeneration;
+                batchUnits.push_back(u);
+            }
+        }
+
+        if (batchUnits.empty())
+            break;
+
+        TestBatch();
+        tested = true;
+    }
+
+    hotUnits.clear();
+    hotEpoch++;
+
+    pendingUnits = units - visited;
+}
+
+
+//
+// TestBucket(bucket, out)
+//
+//  Test each item in a grid bucket against the rest of its
+//  own cell and the cells right-up, right, right-down, and
+//  down of it, then against higher classes it pairs with in
+//  all nine cells.
+//
+//  This may run on a worker, so it writes nothing. The items
+//  are marked updated afterward by MarkBucket.
+//
+void SS_CollisionManager::TestBucket(unsigned i, SS_PairList *out)
+{
+    static const Sint32 ahead[4][2] = { { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+    SS_Collider         *item;
+    SS_ColliderIterator outer_iter;
+
+    outer_iter = cellList[i].GetIterator();
+
+    while ((item = outer_iter.NextItem()))
+    {
+        if ( !item->IsVisible() )
+            continue;
+
+        Uint8   a = item->collClass;
+        Uint64  pairs = classPairs[a];
+        Sint32  cx = item->cellX, cy = item->cellY;
+
+        // Test all items following in the same cell,
+        // and all items in the cells ahead
+        if ( (pairs >> a) & 1 )
+        {
+            TestList(item, outer_iter, cx, cy, a, out);
+
+            for ( int n = 0; n < 4; n++ )
+            {
+                Sint32 nx = cx + ahead[n][0], ny = cy + ahead[n][1];
+                TestList(item, cellList[CellIndex(nx, ny, a)].GetIterator(), nx, ny, a, out);
+            }
+        }
+
+        // Test higher classes in all nine cells
+        for ( Uint8 b = a + 1; b < SS_COLLISION_CLASSES; b++ )
+        {
+            if ( classCount[b] == 0 || !((pairs >> b) & 1) )
+                continue;
+
+            for ( Sint32 ny = cy - 1; ny <= cy + 1; ny++ )
+                for ( Sint32 nx = cx - 1; nx <= cx + 1; nx++ )
+                    TestList(item, cellList[CellIndex(nx, ny, b)].GetIterator(), nx, ny, b, out);
+        }
+    }
+}
+
+
+//
+// Large colliders
+//
+typedef struct {
+    SS_CollisionManager *manager;
+    SS_Collider         *item;
+    float               left, top, right, bottom;
+} largeQuery;
+
+//
+// LargeVisit(other, query)
+//
+//  Gather a pair for a large collider and one its box
+//  overlaps. Two large colliders find each other both ways,
+//  so only the one with the lower id keeps the pair.
+//
+bool SS_CollisionManager::LargeVisit(SS_Collider *other, void *data)
+{
+    largeQuery          *q = (largeQuery*)data;
+    SS_CollisionManager *cm = q->manager;
+
+    if ( other == q->item || (cm->IsLarge(other) && other->colliderID < q->item->colliderID) )
+        return false;
+
+    float l, t, r, b;
+    other->CollisionBounds(&l, &t, &r, &b);
+    if ( l > q->right || r < q->left || t > q->bottom || b < q->top )
+        return false;
+
+    SS_PairResult res;
+    if ( cm->ProbePair(q->item, other, &res) )
+        cm->visitPairs.push_back(res);
+
+    return false;
+}
+
+//
+// TestLarge
+//
+//  Test each collider in the large list against everything
+//  its box overlaps, however many bands or cells that is.
+//  There are few of these, so they're all tested every time
+//  regardless of the budget.
+//
+void SS_CollisionManager::TestLarge()
+{
+    SS_Collider         *item;
+    SS_ColliderIterator iter = largeList.GetIterator();
+
+    while ((item = iter.NextItem()))
+    {
+        if ( !item->IsVisible() )
+            continue;
+
+        item->collisionUpdated = true;
+
+        largeQuery q;
+        q.manager = this;
+        q.item = item;
+        item->CollisionBounds(&q.left, &q.top, &q.right, &q.bottom);
+
+        visitPairs.clear();
+        VisitBox(q.left, q.top, q.right, q.bottom, LargeVisit, &q);
+
+        for (size_t p = 0; p < visitPairs.size(); p++)
+            ApplyPair(visitPairs[p]);
+    }
+}
+
+
+//
+// RunSweepTest
+//
+//  Walk the sorted boxes, testing each item against those
+//  that start before it ends, if they also overlap on y and
+//  their classes pair. As with the grid, lone items are
+//  still marked updated.
+//
+void SS_CollisionManager::RunSweepTest()
+{
+    UpdatePairs();
+    SweepSort();
+
+    size_t n = sweepOrder.size();
+
+    for ( size_t i = 0; i < n; i++ )
+    {
+        SS_Collider *item = sweepOrder[i];
+        if ( !item->IsVisible() )
+            continue;
+
+        item->collisionUpdated = true;
+
+        Uint64 pairs = classPairs[item->collClass];
+        if ( pairs == 0 )
+            continue;
+
+        for ( size_t j = i + 1; j < n; j++ )
+        {
+            SS_Collider *inner = sweepOrder[j];
+            if ( inner->boxLeft > item->boxRight )
+                break;
+
+            if ( inner->boxTop > item->boxBottom || inner->boxBottom < item->boxTop )
+                continue;
+
+            if ( (pairs >> inner->collClass) & 1 )
+                TestPair(item, inner);
+        }
+    }
+}
+
+
+//
+// Contact pairs are keyed on both colliders' ids, lower first
+//
+static inline Uint64 contact_key(Uint32 ia, Uint32 ib)
+{
+    return (ia < ib) ? ((Uint64)ia << 32 | ib) : ((Uint64)ib << 32 | ia);
+}
+
+static inline void contact_pose(SS_Collider *item, SS_ContactPose *pose)
+{
+    SS_Point p;
+    item->GlobalPosition(&p);
+    pose->x     = p.x;
+    pose->y     = p.y;
+    pose->angle = p.i;
+    pose->frame = item->FrameIndex();
+}
+
+//
+// TestPair(a, b, out)
+//
+//  TestCollision for the world's own passes, which also
+//  keeps the contact pairs. The result is applied at once,
+//  or added to the out list for a worker's batch.
+//
+void SS_CollisionManager::TestPair(SS_Collider *a, SS_Collider *b, SS_PairList *out)
+{
+    SS_PairResult r;
+
+    if ( !ProbePair(a, b, &r) )
+        return;
+
+    if (out)
+        out->push_back(r);
+    else
+        ApplyPair(r);
+}
+
+//
+// ProbePair(a, b, result)
+//
+//  The read-only half of a pair test, safe on any thread.
+//  A pair found touching last time that hasn't moved, turned,
+//  or changed frame since is still touching, so the narrow
+//  phase is skipped. Pairs only met along a swept path don't
+//  count, as they were apart at the end of it. Returns false
+//  if the two can't collide.
+//
+bool SS_CollisionManager::ProbePair(SS_Collider *a, SS_Collider *b, SS_PairResult *r) const
+{
+    if ( !a->CanCollide(b) )
+        return false;
+
+    r->a = a;
+    r->b = b;
+    r->time = 1;
+    r->narrow = false;
+    r->hit = false;
+
+    if (!a->oversize && !b->oversize && a->DistanceSquaredTo(b) > SS_COLLISION_BAND_SIZE*SS_COLLISION_BAND_SIZE)
+        return true;
+
+    contact_pose(a, &r->poseA);
+    contact_pose(b, &r->poseB);
+
+    SS_ContactMap::const_iterator found = contacts.find(contact_key(a->colliderID, b->colliderID));
+    if (found != contacts.end())
+    {
+        const SS_Contact &c = found->second;
+        if ( c.time >= 1 && ((c.a == a) ? (c.poseA == r->poseA && c.poseB == r->poseB) : (c.poseA == r->poseB && c.poseB == r->poseA)) )
+        {
+            r->hit = true;
+            return true;
+        }
+    }
+
+    r->narrow = true;
+    r->hit = a->_TestCollision(b);
+    return true;
+}
+
+//
+// ApplyPair(result)
+//
+//  The writing half, on the main thread: flag both items,
+//  start or renew their contact, and add the collision bits.
+//
+void SS_CollisionManager::ApplyPair(const SS_PairResult &r)
+{
+    SS_Collider *a = r.a, *b = r.b;
+
+    a->collisionUpdated = b->collisionUpdated = true;
+
+    collisionStats.candidates++;
+    if (r.narrow) collisionStats.narrow++;
+
+    if ( !r.hit )
+        return;
+
+    collisionStats.hits++;
+
+    Uint64 key = contact_key(a->colliderID, b->colliderID);
+
+    SS_ContactMap::iterator found = contacts.find(key);
+    if (found != contacts.end())
+    {
+        SS_Contact &c = found->second;
+        c.generation = contactGeneration;
+        c.time = r.time;
+        if (c.a == a) { c.poseA = r.poseA; c.poseB = r.poseB; }
+        else          { c.poseA = r.poseB; c.poseB = r.poseA; }
+    }
+    else
+    {
+        SS_Contact c = { a, b, r.poseA, r.poseB, contactGeneration, r.time, false };
+        contacts[key] = c;
+        a->contactCount++;
+        b->contactCount++;
+    }
+
+    a->CollideWith(b);
+    b->CollideWith(a);
+}
+
+//
+// DispatchContacts
+//
+//  Report each contact to both colliders: begin the first
+//  time it's found, stay while it goes on, and end once a
+//  test finds them apart. A pair only ends once the units
+//  of both its colliders have been tested, as either might
+//  be the one it's found from. Pairs with a large collider
+//  are tested every time. Events are gathered first, and
+//  a collider that leaves during dispatch has its pending
+//  events blanked by DropContacts, so a handler may remove
+//  or delete either collider.
+//
+void SS_CollisionManager::DispatchContacts()
+{
+    std::vector<SS_ContactEvent> &events = contactEvents;
+    bool sweep = (broadphase == SS_BROADPHASE_SWEEP);
+
+    events.clear();
+
+    for (SS_ContactMap::iterator i = contacts.begin(); i != contacts.end(); )
+    {
+        SS_Contact &c = i->second;
+
+        if (c.generation != contactGeneration
+            && (sweep || IsLarge(c.a) || IsLarge(c.b)
+                || (unitTested[UnitOf(c.a)] == contactGeneration && unitTested[UnitOf(c.b)] == contactGeneration)))
+        {
+            SS_ContactEvent e = { c.a, c.b, SS_CONTACT_END };
+            events.push_back(e);
+            c.a->contactCount--;
+            c.b->contactCount--;
+            i = contacts.erase(i);
+            continue;
+        }
+
+        if (c.generation == contactGeneration)
+        {
+            SS_ContactEvent e = { c.a, c.b, c.begun ? SS_CONTACT_STAY : SS_CONTACT_BEGIN };
+            events.push_back(e);
+            c.begun = true;
+        }
+
+        ++i;
+    }
+
+    for (size_t i=0; i < events.size(); i++)
+    {
+        SS_ContactEvent &e = events[i];
+
+        if (e.a) e.a->HandleCollision(e.b, e.phase);
+        if (e.a) e.b->HandleCollision(e.a, e.phase);
+    }
+
+    events.clear();
+}
+
+//
+// DropContacts(item)
+//
+//  Forget a collider's contacts as it leaves. No end is
+//  reported, as the item may be on its way to deletion.
+//  Events still waiting in a dispatch are blanked.
+//
+void SS_CollisionManager::DropContacts(SS_Collider *item)
+{
+    for (size_t i=0; i < contactEvents.size(); i++)
+    {
+        SS_ContactEvent &e = contactEvents[i];
+        if (e.a == item || e.b == item)
+            e.a = e.b = nullptr;
+    }
+
+    if (item->contactCount == 0)
+        return;
+
+    for (SS_ContactMap::iterator i = contacts.begin(); i != contacts.end(); )
+    {
+        SS_Contact &c = i->second;
+
+        if (c.a == item || c.b == item)
+        {
+            c.a->contactCount--;
+            c.b->contactCount--;
+            i = contacts.erase(i);
+        }
+        else
+            ++i;
+    }
+}
+
+
+//
+// ContactTime(a, b, &time)
+//
+//  How far through the last move two touching colliders
+//  met, from 0 to 1. Pairs found touching where they ended
+//  up give 1; less means a swept test caught them part way.
+//  Returns false if they aren't in contact.
+//
+bool SS_CollisionManager::ContactTime(SS_Collider *a, SS_Collider *b, float *time) const
+{
+    SS_ContactMap::const_iterator found = contacts.find(contact_key(a->colliderID, b->colliderID));
+    if (found == contacts.end())
+        return false;
+
+    if (time) *time = found->second.time;
+    return true;
+}
+
+
+//
+// Swept tests
+//
+//  A collider set continuous with SetContinuous also has
+//  the path it moved along since the last test checked, so
+//  a fast bullet can't step over a thin target between two
+//  tests. The path is the one its center took, from where
+//  the last test left it to where it is now, whatever moved
+//  it. Its box is grown along the path and tested against
+//  the boxes of the colliders it could reach, so like items
+//  without masks a swept hit is only as exact as the boxes.
+//  If the other collider is continuous too, their moves are
+//  taken relative to each other.
+//
+//  Swept hits become contacts like any other, with the time
+//  of impact kept for ContactTime, and are reported with the
+//  rest by DispatchContacts.
+//
+typedef struct {
+    SS_Collider     *mover;
+    float           x0, y0, x1, y1;                 // the path of its center
+    float           left, top, right, bottom;       // its box about its center
+    SS_PairList     *hits;
+} sweptQuery;
+
+//
+// swept_hit(item, data)
+//
+//  Slab test the mover's path against the item's box, grown
+//  by the mover's. The path starts as far off as the item
+//  moved, so the item can be taken as still.
+//
+static bool swept_hit(SS_Collider *item, void *data)
+{
+    sweptQuery *q = (sweptQuery*)data;
+
+    if ( item == q->mover || !q->mover->CanCollide(item) )
+        return false;
+
+    SS_Point    op;
+    item->GlobalPosition(&op);
+
+    float   org[2] = { q->x0, q->y0 };
+    if (item->IsContinuous()) {
+        org[0] += op.x - item->sweepX;
+        org[1] += op.y - item->sweepY;
+    }
+
+    float   dir[2] = { q->x1 - org[0], q->y1 - org[1] };
+    if (dir[0] * dir[0] + dir[1] * dir[1] < 1.0f)
+        return false;
+
+    float l, t, r, b;
+    item->CollisionBounds(&l, &t, &r, &b);
+
+    float   lo = 0, hi = 1;
+    float   mins[2] = { l - q->right, t - q->bottom }, maxs[2] = { r - q->left, b - q->top };
+
+    for (int a=0; a<2; a++)
+    {
+        if (fabsf(dir[a]) < 1e-6f)
+        {
+            if (org[a] < mins[a] || org[a] > maxs[a])
+                return false;
+        }
+        else
+        {
+            float t1 = (mins[a] - org[a]) / dir[a];
+            float t2 = (maxs[a] - org[a]) / dir[a];
+            if (t1 > t2) { float tt = t1; t1 = t2; t2 = tt; }
+            if (t1 > lo) lo = t1;
+            if (t2 < hi) hi = t2;
+            if (lo > hi) return false;
+        }
+    }
+
+    SS_PairResult res;
+    res.a = q->mover;
+    res.b = item;
+    res.time = lo;
+    res.narrow = false;
+    res.hit = true;
+    contact_pose(q->mover, &res.poseA);
+    contact_pose(item, &res.poseB);
+    q->hits->push_back(res);
+
+    return false;
+}
+
+//
+// RunContinuousTest
+//
+//  Sweep each continuous collider along its path and apply
+//  what it hits, skipping pairs already found touching this
+//  test. The paths all start from the last test's positions,
+//  so they're only moved on once every one is done.
+//
+void SS_CollisionManager::RunContinuousTest()
+{
+    size_t      n = continuousItems.size();
+    SS_Point    p;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        SS_Collider *item = continuousItems[i];
+        if ( !item->IsVisible() )
+            continue;
+
+        item->GlobalPosition(&p);
+        float dx = p.x - item->sweepX, dy = p.y - item->sweepY;
+        if (dx * dx + dy * dy < 1.0f)
+            continue;
+
+        float l, t, r, b;
+        item->CollisionBounds(&l, &t, &r, &b);
+
+        sweptQuery q = { item, item->sweepX, item->sweepY, p.x, p.y, l - p.x, t - p.y, r - p.x, b - p.y, &visitPairs };
+
+        visitPairs.clear();
+        VisitBox(MIN(l, l - dx), MIN(t, t - dy), MAX(r, r - dx), MAX(b, b - dy), swept_hit, &q);
+
+        for (size_t h = 0; h < visitPairs.size(); h++)
+        {
+            SS_PairResult &res = visitPairs[h];
+
+            SS_ContactMap::iterator found = contacts.find(contact_key(res.a->colliderID, res.b->colliderID));
+            if (found == contacts.end() || found->second.generation != contactGeneration)
+                ApplyPair(res);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        continuousItems[i]->GlobalPosition(&p);
+        continuousItems[i]->sweepX = p.x;
+        continuousItems[i]->sweepY = p.y;
+    }
+}
+
+//
+// AddContinuous(item)
+//
+void SS_CollisionManager::AddContinuous(SS_Collider *item)
+{
+    continuousItems.push_back(item);
+    item->ResetSweep();
+}
+
+//
+// RemoveContinuous(item)
+//
+void SS_CollisionManager::RemoveContinuous(SS_Collider *item)
+{
+    for (size_t i = 0; i < continuousItems.size(); i++)
+        if (continuousItems[i] == item) {
+            continuousItems.erase(continuousItems.begin() + i);
+            break;
+        }
+}
+
+
+//
+// VisitAround(cellX, cellY, proc, data)
+//
+//  Pass the colliders listed in the three bands or nine
+//  cells around a band or cell, and the large ones, to a
+//  proc until it returns true. When sweeping there are no
+//  cells, so every collider is passed.
+//
+bool SS_CollisionManager::VisitAround(Sint32 cx, Sint32 cy, colliderProc proc, void *data)
+{
+    SS_Collider         *item;
+    SS_ColliderIterator iter;
+
+    if (broadphase == SS_BROADPHASE_SWEEP)
+    {
+        for ( size_t i = 0; i < sweepOrder.size(); i++ )
+            if ( (item = sweepOrder[i]) && proc(item, data) )
+                return true;
+
+        return false;
+    }
+
+    for ( Uint8 c = 0; c < SS_COLLISION_CLASSES; c++ )
+    {
+        if ( classCount[c] == 0 )
+            continue;
+
+        // The nine cells around this one
+        if (broadphase == SS_BROADPHASE_GRID)
+        {
+            for ( Sint32 ny = cy - 1; ny <= cy + 1; ny++ )
+                for ( Sint32 nx = cx - 1; nx <= cx + 1; nx++ )
+                {
+                    iter = cellList[CellIndex(nx, ny, c)].GetIterator();
+                    while ((item = iter.NextItem()))
+                        if ( item->cellX == nx && item->cellY == ny && item->collClass == c && proc(item, data) )
+                            return true;
+                }
+
+            continue;
+        }
+
+        // The three lists neighboring this one
+        for ( unsigned i=0; i<=2; i++ )
+        {
+            unsigned curr = (cx + i + SS_COLLISION_LISTS - 1) % SS_COLLISION_LISTS;
+            iter = colliderList[c][curr].GetIterator();
+            while ((item = iter.NextItem()))
+                if ( proc(item, data) )
+                    return true;
+        }
+    }
+
+    // Large colliders could reach from anywhere
+    iter = largeList.GetIterator();
+    while ((item = iter.NextItem()))
+        if ( proc(item, data) )
+            return true;
+
+    return false;
+}
+
 //
-//  This is one means of making collisions go faster. See
-//  optimization notes below for upcoming development paths.
+// VisitNear(x, y, proc, data)
+// Pass the colliders that might be at a point to a proc
 //
-#define COLLISION_SLEW  2
+bool SS_CollisionManager::VisitNear(float x, float y, colliderProc proc, void *data)
+{
+    Sint32 cx, cy;
+    ListIndexFor(x, y, 0, &cx, &cy);
+    return VisitAround(cx, cy, proc, data);
+}
+
 
 //
-// SLEW_SEGMENT_SIZE calculates lists divided by slew
+// VisitBox(left, top, right, bottom, proc, data)
 //
-#define SLEW_SEGMENT_SIZE       (SS_COLLISION_LISTS/COLLISION_SLEW)
-
+//  Pass the colliders that might overlap a box to a proc,
+//  until it returns true: those in the bands or cells the
+//  box covers, one more all around, as colliders can hang
+//  over the edge of their own, and the large ones. When
+//  sweeping every collider is passed.
 //
-//--------------------------------------------------------------
+bool SS_CollisionManager::VisitBox(float left, float top, float right, float bottom, colliderProc proc, void *data)
+{
+    SS_Collider         *item;
+    SS_ColliderIterator iter;
 
-#define SPATIAL_INDEX(x)    ( ((x) < 0) \
-                            ? (SS_COLLISION_LISTS - 1) - (Uint16)floorf(-(x) / SS_COLLISION_BAND_SIZE) % SS_COLLISION_LISTS \
-                            : (Uint16)floorf((x) / SS_COLLISION_BAND_SIZE) % SS_COLLISION_LISTS )
+    if (broadphase == SS_BROADPHASE_SWEEP)
+        return VisitAround(0, 0, proc, data);
+
+    bool    grid = (broadphase == SS_BROADPHASE_GRID);
+    float   size = grid ? cellSize : (float)SS_COLLISION_BAND_SIZE;
+    Sint32  x1 = (Sint32)floorf(left / size) - 1, x2 = (Sint32)floorf(right / size) + 1;
+    Sint32  y1 = (Sint32)floorf(top / size) - 1, y2 = (Sint32)floorf(bottom / size) + 1;
+
+    for ( Uint8 c = 0; c < SS_COLLISION_CLASSES; c++ )
+    {
+        if ( classCount[c] == 0 )
+            continue;
+
+        if (grid)
+        {
+            for ( Sint32 ny = y1; ny <= y2; ny++ )
+                for ( Sint32 nx = x1; nx <= x2; nx++ )
+                {
+                    iter = cellList[CellIndex(nx, ny, c)].GetIterator();
+                    while ((item = iter.NextItem()))
+                        if ( item->cellX == nx && item->cellY == ny && item->collClass == c && proc(item, data) )
+                            return true;
+                }
+
+            continue;
+        }
+
+        // Bands wrap, so don't go around more than once
+        unsigned first = SPATIAL_INDEX(left) + SS_COLLISION_LISTS - 1,
+                 count = MIN((unsigned)(x2 - x1 + 1), (unsigned)SS_COLLISION_LISTS);
+
+        for ( unsigned i = 0; i < count; i++ )
+        {
+            iter = colliderList[c][(first + i) % SS_COLLISION_LISTS].GetIterator();
+            while ((item = iter.NextItem()))
+                if ( proc(item, data) )
+                    return true;
+        }
+    }
+
+    iter = largeList.GetIterator();
+    while ((item = iter.NextItem()))
+        if ( proc(item, data) )
+            return true;
+
+    return false;
+}
 
 
-//--------------------------------------------------------------
-//
-// SS_CollisionManager
-//
-//  Manages colliders in an optimal manner, dividing them up into
-//  linked lists based on collision id and physical position.
 //
-//  This is implemented as linked lists so the nodes may be
-//  scattered and non-optimal for caching, so reducing tests is
-//  important. Lists are likely to change often, but may still
-//  be optimizable by implementing using self-sizing arrays.
+// Point queries
 //
-//--------------------------------------------------------------
+typedef struct {
+    float           x, y;
+    Uint32          mask;
+    SS_Collider     **buffer;
+    int             max, count;
+    SS_ColliderList *list;
+} pointQuery;
 
+static inline bool query_accepts(SS_Collider *item, Uint32 mask)
+{
+    return item->IsVisible() && (mask == 0 || (item->CollisionIn() & mask) != 0);
+}
 
-SS_CollisionManager::SS_CollisionManager()
+static bool point_first(SS_Collider *item, void *data)
 {
-    Init();
+    pointQuery *q = (pointQuery*)data;
+
+    if ( query_accepts(item, q->mask) && item->TestPointCollision(q->x, q->y) ) {
+        q->buffer[0] = item;
+        q->count = 1;
+        return true;
+    }
+
+    return false;
 }
 
-void SS_CollisionManager::Init()
+static bool point_gather(SS_Collider *item, void *data)
 {
-/*
-    for (int j=0; j < SS_COLLISION_TYPES; i++)
-        for (int i=0; i < SS_COLLISION_LISTS; i++)
-            colliderList[j][i].Clear();
-*/
+    pointQuery *q = (pointQuery*)data;
+
+    if ( query_accepts(item, q->mask) && item->TestPointCollision(q->x, q->y) )
+    {
+        if (q->list)
+            q->list->Append(item);
+        else
+            q->buffer[q->count] = item;
+
+        if (++q->count == q->max)
+            return true;
+    }
 
-    for (int i=0; i < SS_COLLISION_LISTS; i++)
-        colliderList[i].Clear();
+    return false;
 }
 
 //
-//  Collision lists represent swaths of space of a given
-//  width and infinite height. So if you use 200 lists
-//  with each representing a 512 pixel-wide swath, the
-//  list encompasses all colliders in each 102,400 pixel-
-//  wide region of the world in a single model. Every
-//  item in each list will either be very close to each
-//  other or very far away. In this arrangement it is only
-//  necessary to test collisions between an item and the
-//  items which follow it in its own list, and only its
-//  right neighboring collision list.
+// CollidersAtPoint(x, y, mask)
 //
-//  The side-effect of this scheme is that the collision
-//  lists need to be dynamic. Items need to be moved to the
-//  appropriate collision list in response to motion in the
-//  world. (TODO: Allow custom rules for placement?)
+//  A new list of all the colliders at a point, which the
+//  caller should delete. With a mask, only colliders that
+//  accept one of its bits are included.
 //
+SS_ColliderList* SS_CollisionManager::CollidersAtPoint(float x, float y, Uint32 mask)
+{
+    SS_ColliderList *list = new SS_ColliderList();
 
-//
-// AddToColliders
-// Add a layeritem to the collision pool
-//
+    pointQuery q = { x, y, mask, nullptr, -1, 0, list };
+    VisitNear(x, y, point_gather, &q);
 
-SS_ColliderNode* SS_CollisionManager::AddToColliders(SS_Collider *item)
-{
-    if (item->Layer() && item->World())
-    {
-        SS_Point    pos;
-        item->GlobalPosition(&pos);
-        float xx = pos.x;
-        return colliderList[SPATIAL_INDEX(xx)].Append(item);
-    }
-    else
-        return nullptr;
+    return list;
 }
 
 //
-// SS_World::RunCollisionTest
-// Test all the sprite collisions in the world
+// CollidersAtPoint(x, y, buffer, max, mask)
+// Fill a buffer with up to max colliders at a point
 //
+int SS_CollisionManager::CollidersAtPoint(float x, float y, SS_Collider **buffer, int max, Uint32 mask)
+{
+    if (max <= 0)
+        return 0;
+
+    pointQuery q = { x, y, mask, buffer, max, 0, nullptr };
+    VisitNear(x, y, point_gather, &q);
+
+    return q.count;
+}
 
 //
-// Optimization Notes (TODO:)
-//
-//  The current model is a single self-migrating multi-list
-//  that moves nodes from list to list based on their spatial
-//  (x) position.
-//  Node propagation is clean and efficient as possible -
-//  implemented at the linked list template class level.
-//  However, it is currently implemented by SS_LayerItem
-//  rather than SS_CollisionManager
-//
-//  Node propagation won't need to change much, except to
-//  move node propagation to an encapsulating class.
-//
-//  The first optimization will be to further break these
-//  collision lists into discrete groups based on the
-//  collision id (collisionOut) of their members - a single
-//  number.
-//
-//  RunCollisionTest will then only test each item against
-//  the collision lists of the items which can collide
-//  with it, and which are also in its spatial sphere.
+// FirstColliderAt(x, y, mask)
 //
-//  As with the spatial lists, colliders don't need to check
-//  against lower-numbered lists.
+SS_Collider* SS_CollisionManager::FirstColliderAt(float x, float y, Uint32 mask)
+{
+    SS_Collider *found = nullptr;
+
+    pointQuery q = { x, y, mask, &found, 1, 0, nullptr };
+    VisitNear(x, y, point_first, &q);
+
+    return found;
+}
+
+
 //
-//  An optimal scheme would maintain a Generate / Receive
-//  list, with all unique pairs represented.
+// Line queries
 //
+#define LINE_SEEN   32
+
+typedef struct {
+    float           x, y;           // start
+    float           dx, dy;         // unit direction
+    float           length;
+    Uint32          mask;
+    SS_Collider     *best;
+    float           bestDist;
+    SS_Collider     *seen[LINE_SEEN];
+    int             seenCount;
+} lineQuery;
+
 //
-//  layerItem->SetCollisionOut(COLL_SHIP);  // add this item to the COLL_SHIP collision-group (and remember the node)
-//  layerItem->SetCollisionIn(COLL_ROCK);   // append COLL_ROCK to its node's list of groups to test
-//  layerItem->ClearCollisionIn(COLL_ROCK); // remove COLL_ROCK from its node's list of groups to test
-//  layerItem->ClearCollisionOut();         // remove this item from its collision-group (and forget the node)
+// line_hit(item, data)
 //
+//  Clip the line to the item's box, then step along it a
+//  unit at a time testing points until one hits. Items
+//  already measured aren't measured again, so long as
+//  there's room to remember them.
 //
-void SS_CollisionManager::RunCollisionTest()
+static bool line_hit(SS_Collider *item, void *data)
 {
-    #if COLLISION_SLEW > 1
-        static  Uint16 collisionSlew = 0;
-    #else
-        static constexpr Uint16 collisionSlew = 0;
-    #endif
+    lineQuery *q = (lineQuery*)data;
 
-/*
-    static Uint32   collTick;
-    if (GetWorldTime() - collTick < 5)
-        return;
-    collTick = GetWorldTime();
-*/
+    if ( !query_accepts(item, q->mask) )
+        return false;
 
-    #if COLLISION_SLEW > 1
-    collisionSlew = ++collisionSlew % COLLISION_SLEW;
-    #endif
+    float l, t, r, b;
+    item->CollisionBounds(&l, &t, &r, &b);
 
-    SS_Collider         *item, *inner;
-    SS_ColliderIterator outer_iter, inner_iter;
+    // Slab test against the box
+    float   lo = 0, hi = q->length;
+    float   org[2] = { q->x, q->y }, dir[2] = { q->dx, q->dy };
+    float   mins[2] = { l, t }, maxs[2] = { r, b };
 
-    //
-    // Test a group of lists, or all if SLEW == 1
-    //
-    for ( unsigned i = collisionSlew * SLEW_SEGMENT_SIZE; i < (collisionSlew + 1) * SLEW_SEGMENT_SIZE; i++ )
+    for (int a=0; a<2; a++)
     {
-        if ( colliderList[i].m_count > 0 )
+        if (fabsf(dir[a]) < 1e-6f)
         {
-            outer_iter = colliderList[i].GetIterator();
+            if (org[a] < mins[a] || org[a] > maxs[a])
+                return false;
+        }
+        else
+        {
+            float t1 = (mins[a] - org[a]) / dir[a];
+            float t2 = (maxs[a] - org[a]) / dir[a];
+            if (t1 > t2) { float tt = t1; t1 = t2; t2 = tt; }
+            if (t1 > lo) lo = t1;
+            if (t2 < hi) hi = t2;
+            if (lo > hi) return false;
+        }
+    }
 
-            while ((item = outer_iter.NextItem()))
-            {
-                if ( item->IsVisible() )
-                {
-                    // Test all items following in the same list
-                    inner_iter = outer_iter;
-                    while ((inner = inner_iter.NextItem()))
-                        if ( item->TestCollision(inner) )
-                            item->CollideWith(inner), inner->CollideWith(item);
-
-                    // Test all items in the list to the right
-                    inner_iter = colliderList[(i + 1) % SS_COLLISION_LISTS].GetIterator();
-                    while ((inner = inner_iter.NextItem()))
-                        if ( item->TestCollision(inner) )
-                            item->CollideWith(inner), inner->CollideWith(item);
-                }
-            }
+    // Nothing in here can beat the best so far
+    if (q->best && lo >= q->bestDist)
+        return false;
+
+    for (int i=0; i < q->seenCount; i++)
+        if (q->seen[i] == item)
+            return false;
+
+    if (q->seenCount < LINE_SEEN)
+        q->seen[q->seenCount++] = item;
+
+    for (float d = lo; ; d += 1.0f)
+    {
+        if (d > hi) d = hi;
+
+        if ( q->best && d >= q->bestDist )
+            break;
+
+        if ( item->TestPointCollision(q->x + q->dx * d, q->y + q->dy * d) )
+        {
+            q->best = item;
+            q->bestDist = d;
+            break;
         }
+
+        if (d == hi)
+            break;
     }
-}
 
+    return false;
+}
 
 //
-// CollidersAtPoint
-// Find the first item that lies on the line
+// FirstColliderOnLine(x1, y1, x2, y2, &distance, mask)
+//
+//  Find the first collider along a line, and how far along
+//  the line it is. The line walks the bands or grid cells it
+//  crosses in order, testing the colliders around each, and
+//  stops once a hit is closer than the edge of the cell it's
+//  in. Like the pair tests this relies on colliders being no
+//  bigger than a band or cell. With a mask, only colliders
+//  that accept one of its bits are found.
 //
-SS_ColliderList* SS_CollisionManager::CollidersAtPoint(float x, float y)
+SS_Collider* SS_CollisionManager::FirstColliderOnLine(float x1, float y1, float x2, float y2, float *distance, Uint32 mask)
 {
-    SS_ColliderList *list = new SS_ColliderList();
-    return list;
-}
+    lineQuery   q;
+    float       dx = x2 - x1, dy = y2 - y1;
+    float       len = sqrtf(dx * dx + dy * dy);
 
-SS_Collider* SS_CollisionManager::FirstColliderOnLine(float x1, float y1, float x2, float y2)
-{
-    return nullptr;
-}
+    if (len < 1e-6f)
+    {
+        SS_Collider *item = FirstColliderAt(x1, y1, mask);
+        if (item && distance) *distance = 0;
+        return item;
+    }
 
-SS_Collider* SS_CollisionManager::FirstColliderAt(float x, float y)
-{
-    SS_Collider         *item;
-    SS_ColliderIterator iter;
+    q.x = x1;           q.y = y1;
+    q.dx = dx / len;    q.dy = dy / len;
+    q.length = len;
+    q.mask = mask;
+    q.best = nullptr;
+    q.bestDist = len;
+    q.seenCount = 0;
 
-    // Test the three lists neighboring this point
-    unsigned xlist = SPATIAL_INDEX(x);
-    for ( unsigned i=0; i<=2; i++ )
+    if (broadphase == SS_BROADPHASE_SWEEP)
     {
-        unsigned curr = (xlist + i + SS_COLLISION_LISTS - 1) % SS_COLLISION_LISTS;
-        if ( colliderList[curr].m_count )
+        // No cells to walk, but the boxes are sorted on x
+        float   minX = MIN(x1, x2), maxX = MAX(x1, x2);
+        float   l, t, r, b;
+
+        for ( size_t i = 0; i < sweepOrder.size(); i++ )
         {
-            iter = colliderList[curr].GetIterator();
-            while ((item = iter.NextItem()))
-                if ( item->IsVisible() && item->TestPointCollision(x, y) )
-                    return item;
+            SS_Collider *item = sweepOrder[i];
+            if ( !item )
+                continue;
+
+            item->CollisionBounds(&l, &t, &r, &b);
+            if ( r >= minX && l <= maxX )
+                line_hit(item, &q);
+        }
+    }
+    else
+    {
+        // Amanatides & Woo: step to whichever cell edge is nearer
+        bool    grid = (broadphase == SS_BROADPHASE_GRID);
+        float   size = grid ? cellSize : (float)SS_COLLISION_BAND_SIZE;
+        Sint32  cx = (Sint32)floorf(x1 / size), cy = grid ? (Sint32)floorf(y1 / size) : 0;
+        int     sx = (q.dx > 0) ? 1 : -1, sy = (q.dy > 0) ? 1 : -1;
+        float   tDeltaX = (q.dx != 0) ? size / fabsf(q.dx) : FLT_MAX;
+        float   tDeltaY = (grid && q.dy != 0) ? size / fabsf(q.dy) : FLT_MAX;
+        float   tMaxX = (q.dx != 0) ? ((cx + (sx > 0)) * size - x1) / q.dx : FLT_MAX;
+        float   tMaxY = (grid && q.dy != 0) ? ((cy + (sy > 0)) * size - y1) / q.dy : FLT_MAX;
+
+        for (int steps = 0; ; steps++)
+        {
+            if (grid)
+                VisitAround(cx, cy, line_hit, &q);
+            else
+                VisitNear((cx + 0.5f) * size, y1, line_hit, &q);
+
+            float tExit = MIN(tMaxX, tMaxY);
+
+            // Done at the line's end, at a hit inside this cell,
+            // or when bands start coming around again
+            if ( tExit >= len || (q.best && q.bestDist <= tExit) )
+                break;
+
+            if ( !grid && steps >= SS_COLLISION_LISTS )
+                break;
+
+            if (tMaxX < tMaxY) {
+                cx += sx;
+                tMaxX += tDeltaX;
+            }
+            else {
+                cy += sy;
+                tMaxY += tDeltaY;
+            }
         }
     }
 
-    return nullptr;
+    if (q.best && distance)
+        *distance = q.bestDist;
+
+    return q.best;
 }
 
 void SS_CollisionManager::DrawCollisionGraph()
@@ -247,14 +1816,28 @@ void SS_CollisionManager::DrawCollisionGraph()
     //
     // Draw a bar graph of the collision list lengths
     //
+    //  Bars sum a band's classes, or with the grid a run
+    //  of buckets, as there are too many to show.
+    //
+    int lists = SS_COLLISION_CELLS, per = (lists + SS_COLLISION_LISTS - 1) / SS_COLLISION_LISTS;
+
     glColor4ub(0xF0, 0xFF, 0x00, 0xFF);
     for (int q=0; q < SS_COLLISION_LISTS; q++)
     {
         float x1 = 10 + q * 10;
         float x2 = x1 + 8;
-        float y2 = ss_video_h - 5;
 
-        for (int j=0; j<colliderList[q].m_count; j++)
+        int count = 0;
+        if (broadphase == SS_BROADPHASE_SWEEP)
+            count = q ? 0 : sweepList.m_count;
+        else if (broadphase == SS_BROADPHASE_GRID)
+            for (int k=q * per; k < lists && k < (q + 1) * per; k++)
+                count += cellList[k].m_count;
+        else
+            for (int c=0; c < SS_COLLISION_CLASSES; c++)
+                count += colliderList[c][q].m_count;
+
+        for (int j=0; j<count; j++)
         {
             float y1 = ss_video_h - 5 - j * 5;
             glRectf(x1, y1, x2, y1 + 3);
@@ -276,6 +1859,8 @@ void SS_CollisionManager::DrawCollisionGraph()
 void SS_Collider::Init()
 {
     collNode            = nullptr;
+    collManager         = nullptr;
+    collClass           = SS_COLLISION_RECEIVER;
     isCollider          = false;
     collisions          = 0;
     collisionOut        = 0;
@@ -284,6 +1869,15 @@ void SS_Collider::Init()
     collisionIgnore     = 0;
     collisionSource     = 0;
     listNumber          = -1;
+    cellX = cellY       = 0;
+    oversize            = false;
+    boxLeft = boxTop    = 0;
+    boxRight = boxBottom= 0;
+    sweepIndex          = -1;
+    colliderID          = 0;
+    contactCount        = 0;
+    continuous          = false;
+    sweepX = sweepY     = 0;
 }
 
 //
@@ -326,12 +1920,16 @@ void SS_Collider::RemoveSelf()
 // _Process
 //
 //  Do all necessary processing based on time elapsed
-//  and update its node in the collision lists.
+//  and update its node in the collision lists. While the
+//  world runs layers in parallel the lists are shared, so
+//  the update waits for FinishParallel.
 //
 void SS_Collider::_Process()
 {
     SS_LayerItem::_Process();
-    UpdateNodePosition();
+
+    if (!world->IsDeferringNodes())
+        UpdateNodePosition();
 }
 
 //
@@ -355,7 +1953,11 @@ const SS_Collider& SS_Collider::operator=(const SS_Collider &src)
         // Initialize collision membership
         isCollider      = false;
         collNode        = nullptr;
+        collManager     = nullptr;
         listNumber      = -1;
+        sweepIndex      = -1;
+        colliderID      = 0;
+        contactCount    = 0;
 
         // Initialize collision testing
         collisions      = 0;
@@ -366,6 +1968,7 @@ const SS_Collider& SS_Collider::operator=(const SS_Collider &src)
         collisionOut    = src.collisionOut;
         collisionIn     = src.collisionIn;
         collisionSource = src.collisionSource;
+        continuous      = src.continuous;
     }
 
     return *this;
@@ -379,6 +1982,10 @@ void SS_Collider::EnableCollisions(Uint32 out, Uint32 in)
 {
     DEBUGF(1, "[%p] SS_Collider::EnableCollisions(%04X, %04X)\n", this, out, in);
 
+    // The class and pair table depend on the old masks
+    if (isCollider && (out != collisionOut || in != collisionIn))
+        RemoveFromColliders();
+
     collisionOut = out;
     collisionIn = in;
     collisionIgnore = 0;
@@ -395,6 +2002,41 @@ void SS_Collider::EnableCollisions(Uint32 out, Uint32 in)
     }
 }
 
+//
+// SetContinuous(on)
+//
+//  Also test the path this moves along between collision
+//  tests, for things fast enough to pass through a target
+//  in one move. The path starts from where it is now.
+//
+void SS_Collider::SetContinuous(bool on)
+{
+    if (on == continuous)
+        return;
+
+    continuous = on;
+
+    if (collManager)
+    {
+        if (on)
+            collManager->AddContinuous(this);
+        else
+            collManager->RemoveContinuous(this);
+    }
+}
+
+//
+// ResetSweep
+// Start the next swept path from here, as after a jump
+//
+void SS_Collider::ResetSweep()
+{
+    SS_Point    p;
+    GlobalPosition(&p);
+    sweepX = p.x;
+    sweepY = p.y;
+}
+
 //
 // AddToColliders
 // Add the sprite to the collision pool
@@ -414,7 +2056,7 @@ void SS_Collider::AddToColliders()
 void SS_Collider::RemoveFromColliders()
 {
     if (isCollider) {
-        ColliderNode()->RemoveSelf();
+        collManager->RemoveCollider(this);
         isCollider = false;
         collNode = nullptr;
     }
@@ -426,13 +2068,7 @@ void SS_Collider::RemoveFromColliders()
 void SS_Collider::UpdateNodePosition()
 {
     if (isCollider)
-    {
-        Uint16 x = GetSpatialIndex();
-        if (listNumber != x) {
-            collNode->Migrate(&world->colliderList[x]);
-            listNumber = x;
-        }
-    }
+        world->PlaceCollider(this);
 }
 
 //
@@ -449,6 +2085,13 @@ Uint16 SS_Collider::GetSpatialIndex()
 {
     SS_Point pos;
     GlobalPosition(&pos);
+
+    if (world)
+    {
+        Sint32 cx, cy;
+        return (Uint16)world->ListIndexFor(pos.x, pos.y, collClass, &cx, &cy);
+    }
+
     float xx = pos.x;
     return SPATIAL_INDEX(xx);
 }
@@ -464,6 +2107,16 @@ SS_ColliderList** SS_Collider::ColliderListList()
 }
 */
 
+static bool update_visit(SS_Collider *item, void *data)
+{
+    SS_Collider *self = (SS_Collider*)data;
+
+    if (item != self && self->TestCollision(item))
+        self->CollideWith(item);
+
+    return false;
+}
+
 //
 // UpdateCollisions
 // Test this sprite's collisions against all nearby colliders
@@ -475,17 +2128,89 @@ void SS_Collider::UpdateCollisions()
         SS_World    *w = World();
         SS_Collider   *item;
 
-        int b = listNumber + SS_COLLISION_LISTS - 1;
-        for (int i=0; i<=2; i++)
+        // Test the boxes overlapping this one
+        if (w->broadphase == SS_BROADPHASE_SWEEP)
         {
-            SS_ColliderIterator itr = w->colliderList[(b+i) % SS_COLLISION_LISTS].GetIterator();
-            while ((item = itr.NextItem()))
-                if (item != this && TestCollision(item))
+            float l, t, r, b, il, it, ir, ib;
+            CollisionBounds(&l, &t, &r, &b);
+
+            for (size_t i=0; i < w->sweepOrder.size(); i++)
+            {
+                if (!(item = w->sweepOrder[i]) || item == this || !w->ClassesPair(collClass, item->collClass))
+                    continue;
+
+                item->CollisionBounds(&il, &it, &ir, &ib);
+                if (il <= r && ir >= l && it <= b && ib >= t && TestCollision(item))
                     CollideWith(item);
+            }
+            return;
+        }
+
+        // Too big for the cells around it, so test whatever its box covers
+        if (w->IsLarge(this))
+        {
+            float l, t, r, b;
+            CollisionBounds(&l, &t, &r, &b);
+            w->VisitBox(l, t, r, b, update_visit, this);
+            return;
+        }
+
+        for (Uint8 c=0; c < SS_COLLISION_CLASSES; c++)
+        {
+            if (w->classCount[c] == 0 || !w->ClassesPair(collClass, c))
+                continue;
+
+            // Test the nine cells around this one
+            if (w->broadphase == SS_BROADPHASE_GRID)
+            {
+                for (Sint32 ny = cellY - 1; ny <= cellY + 1; ny++)
+                    for (Sint32 nx = cellX - 1; nx <= cellX + 1; nx++)
+                    {
+                        SS_ColliderIterator itr = w->cellList[SS_CollisionManager::CellIndex(nx, ny, c)].GetIterator();
+                        while ((item = itr.NextItem()))
+                            if (item != this && item->cellX == nx && item->cellY == ny && item->collClass == c && TestCollision(item))
+                                CollideWith(item);
+                    }
+                continue;
+            }
+
+            // Test the three bands around this one
+            int b = cellX + SS_COLLISION_LISTS - 1;
+            for (int i=0; i<=2; i++)
+            {
+                SS_ColliderIterator itr = w->colliderList[c][(b+i) % SS_COLLISION_LISTS].GetIterator();
+                while ((item = itr.NextItem()))
+                    if (item != this && TestCollision(item))
+                        CollideWith(item);
+            }
         }
+
+        // And the large ones, which could reach from anywhere
+        SS_ColliderIterator itr = w->largeList.GetIterator();
+        while ((item = itr.NextItem()))
+            if (TestCollision(item))
+                CollideWith(item);
     }
 }
 
+//
+// CollisionBounds(&left, &top, &right, &bottom)
+//
+//  A box around everything this item could collide with.
+//  By default it's a square the size of a collision band,
+//  which two items overlap whenever they're close enough
+//  for TestCollision to look at them.
+//
+void SS_Collider::CollisionBounds(float *left, float *top, float *right, float *bottom)
+{
+    SS_Point pos;
+    GlobalPosition(&pos);
+
+    const float half = SS_COLLISION_BAND_SIZE / 2.0f;
+    *left = pos.x - half;   *right = pos.x + half;
+    *top = pos.y - half;    *bottom = pos.y + half;
+}
+
 //
 // CollideWith
 //
@@ -499,6 +2224,19 @@ void SS_Collider::CollideWith(SS_Collider *s)
     if (group) group->CollideWith(s);
 }
 
+//
+// HandleCollision(other, phase)
+//
+//  Called as a contact with another collider begins, goes
+//  on, and ends, once per collision test. Override it to
+//  respond to contacts without filtering GetNewCollisions
+//  each frame. By default it passes the event to the group.
+//
+void SS_Collider::HandleCollision(SS_Collider *other, contactPhase phase)
+{
+    if (group) group->HandleCollision(other, phase);
+}
+
 //
 // GetNewCollisions
 // Get new collisions since the last time they were updated
@@ -532,7 +2270,7 @@ bool SS_Collider::TestCollision(SS_Collider *other)
     {
         collisionUpdated = other->collisionUpdated = true;
 
-        if (DistanceSquaredTo(other) > SS_COLLISION_BAND_SIZE*SS_COLLISION_BAND_SIZE)
+        if (!oversize && !other->oversize && DistanceSquaredTo(other) > SS_COLLISION_BAND_SIZE*SS_COLLISION_BAND_SIZE)
             return false;
         else
             return _TestCollision(other);
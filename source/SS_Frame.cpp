@@ -10,6 +10,7 @@
 
 #include "SS_Frame.h"
 
+#include "SS_Game.h"
 #include "SS_Utilities.h"
 
 #include <stdlib.h>
@@ -56,6 +57,10 @@ void SS_Frame::Init(frameFlags f)
     flags           = f;
     surface         = nullptr;
     mask            = nullptr;
+    wideMask        = nullptr;
+#if SS_MASK_ROTATIONS
+    rotMasks        = nullptr;
+#endif
     gl_texture      = 0;
     gl_list         = 0;
     texw            = 0;
@@ -179,6 +184,18 @@ void SS_Frame::DisposeMask()
         free(mask);
         mask = nullptr;
     }
+
+    SS_CollisionMask::Dispose(wideMask);
+    wideMask = nullptr;
+
+#if SS_MASK_ROTATIONS
+    if (rotMasks) {
+        for (int i=1; i < SS_MASK_ROTATIONS; i++)
+            SS_CollisionMask::Dispose(rotMasks[i].load());
+        delete [] rotMasks;
+        rotMasks = nullptr;
+    }
+#endif
 }
 
 //
@@ -252,6 +269,112 @@ void SS_Frame::MakeCollisionMask(Uint8 threshold)
 
         DEBUGF(1, "\n");
     }
+
+    // The same mask in 64-bit rows
+    wideMask = SS_CollisionMask::New(w, h);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (mask[y * bw + x / 8] & (1 << (x % 8)))
+                wideMask->Set(x, y);
+    wideMask->xorigin = w / 2.0f;
+    wideMask->yorigin = h / 2.0f;
+    wideMask->Finish();
+
+#if SS_MASK_ROTATIONS
+    rotMasks = new std::atomic<SS_CollisionMask*>[SS_MASK_ROTATIONS];
+    rotMasks[0].store(wideMask);
+    for (int i=1; i < SS_MASK_ROTATIONS; i++)
+        rotMasks[i].store(nullptr);
+#endif
+}
+
+//
+// RotatedMask(angle)
+//
+//  The collision mask turned to the nearest of the cached
+//  angles, building it the first time it's wanted. This may
+//  be called from several threads at once; if two build the
+//  same mask, the loser throws its copy away. Returns null
+//  if there's no mask, no rotated masks are kept, or the
+//  nearest angle would put the mask's corners more than
+//  half a pixel from where the exact angle puts them.
+//
+const SS_CollisionMask* SS_Frame::RotatedMask(Uint16 angle)
+{
+#if SS_MASK_ROTATIONS
+    if (!rotMasks)
+        return nullptr;
+
+    const Uint32 step = 65536 / SS_MASK_ROTATIONS;
+    int i = ((angle + step / 2) / step) % SS_MASK_ROTATIONS;
+
+    // How far the corners would be off, about the center
+    Sint16  off = (Sint16)(Uint16)(angle - i * step);
+    float   reach = 0.5f * sqrtf((float)wideMask->width * wideMask->width + (float)wideMask->height * wideMask->height);
+    if (abs(off) * reach * (float)(M_PI / 32768) > 0.5f)
+        return nullptr;
+
+    SS_CollisionMask *m = rotMasks[i].load(std::memory_order_acquire);
+    if (m)
+        return m;
+
+    SS_CollisionMask *fresh = BuildRotatedMask((Uint16)(i * step)), *expected = nullptr;
+    if (rotMasks[i].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+        return fresh;
+
+    SS_CollisionMask::Dispose(fresh);
+    return expected;
+#else
+    return angle ? nullptr : wideMask;
+#endif
+}
+
+//
+// BuildRotatedMask(angle)
+//
+//  Turn the mask about its center the same way sprites are
+//  turned, sampling the source at the center of each new
+//  pixel. Turning about the center rather than a corner
+//  halves how far a near angle strays.
+//
+SS_CollisionMask* SS_Frame::BuildRotatedMask(Uint16 angle)
+{
+    float   c = SS_Game::Cos(angle), s = SS_Game::Sin(angle);
+    float   hw = wideMask->width / 2.0f, hh = wideMask->height / 2.0f;
+
+    // Where the corners go, about the center
+    float   cx[4] = { -hw * c + hh * s,  hw * c + hh * s, -hw * c - hh * s,  hw * c - hh * s };
+    float   cy[4] = { -hh * c - hw * s, -hh * c + hw * s,  hh * c - hw * s,  hh * c + hw * s };
+    float   minx = cx[0], maxx = cx[0], miny = cy[0], maxy = cy[0];
+
+    for (int i=1; i<4; i++)
+    {
+        minx = MIN(minx, cx[i]);    maxx = MAX(maxx, cx[i]);
+        miny = MIN(miny, cy[i]);    maxy = MAX(maxy, cy[i]);
+    }
+
+    float   left = floorf(minx), top = floorf(miny);
+    SS_CollisionMask *m = SS_CollisionMask::New((Uint16)(ceilf(maxx) - left), (Uint16)(ceilf(maxy) - top));
+    m->xorigin = -left;
+    m->yorigin = -top;
+
+    for (int v=0; v < m->height; v++)
+    {
+        float dy = v + 0.5f + top;
+        for (int u=0; u < m->width; u++)
+        {
+            float   dx = u + 0.5f + left;
+            int     sx = (int)floorf(dx * c + dy * s + hw);
+            int     sy = (int)floorf(dy * c - dx * s + hh);
+
+            if (sx >= 0 && sx < wideMask->width && sy >= 0 && sy < wideMask->height
+                && (mask[sy * maskBytesWide + sx / 8] & (1 << (sx % 8))))
+                m->Set(u, v);
+        }
+    }
+
+    m->Finish();
+    return m;
 }
 
 
@@ -304,6 +427,9 @@ void SS_Frame::SendGeometry()
 //
 void SS_Frame::InitDisplayList()
 {
+    if (!SS_Game::HasGLContext())
+        return;
+
     if (gl_list == 0)
         gl_list = glGenLists(1);
 
@@ -311,3 +437,187 @@ void SS_Frame::InitDisplayList()
     SendGeometry();
     glEndList();
 }
+
+
+#pragma mark -
+//--------------------------------------------------------------
+// SS_CollisionMask
+//--------------------------------------------------------------
+
+// Masks this small compare quickly enough without blocks
+#define MASK_PYRAMID_MIN    64
+
+// Floor division for block coordinates
+static inline int block_of(int p) { return (p >= 0) ? p / SS_MASK_BLOCK : -((SS_MASK_BLOCK - 1 - p) / SS_MASK_BLOCK); }
+
+//
+// New(width, height)
+// A cleared mask of the given size
+//
+SS_CollisionMask* SS_CollisionMask::New(Uint16 w, Uint16 h)
+{
+    SS_CollisionMask *m = (SS_CollisionMask*)malloc(sizeof(SS_CollisionMask));
+    if (!m)
+        throw "Can't get memory for a collision mask.";
+
+    m->width    = w;
+    m->height   = h;
+    m->words    = (w + 63) / 64;
+    m->xorigin  = 0;
+    m->yorigin  = 0;
+    m->left     = m->top = 0;
+    m->right    = w;
+    m->bottom   = h;
+    m->anyBlocks = m->grownBlocks = m->allBlocks = nullptr;
+    m->bits     = (Uint64*)calloc((size_t)m->words * h + 1, sizeof(Uint64));
+
+    if (!m->bits) {
+        free(m);
+        throw "Can't get memory for a collision mask.";
+    }
+
+    return m;
+}
+
+//
+// Dispose(mask)
+//
+void SS_CollisionMask::Dispose(SS_CollisionMask *m)
+{
+    if (m) {
+        Dispose(m->anyBlocks);
+        Dispose(m->grownBlocks);
+        Dispose(m->allBlocks);
+        free(m->bits);
+        free(m);
+    }
+}
+
+//
+// Finish
+// Find the occupied box and build the coarser levels
+//
+void SS_CollisionMask::Finish()
+{
+    int l = width, t = height, r = 0, b = 0;
+
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            if (Get(x, y))
+            {
+                if (x < l) l = x;
+                if (x >= r) r = x + 1;
+                if (y < t) t = y;
+                b = y + 1;
+            }
+
+    if (r == 0)
+        l = t = 0;
+
+    left = l;   top = t;
+    right = r;  bottom = b;
+
+    if (IsEmpty() || (width <= MASK_PYRAMID_MIN && height <= MASK_PYRAMID_MIN))
+        return;
+
+    Uint16 bw = (width + SS_MASK_BLOCK - 1) / SS_MASK_BLOCK;
+    Uint16 bh = (height + SS_MASK_BLOCK - 1) / SS_MASK_BLOCK;
+
+    anyBlocks   = New(bw, bh);
+    grownBlocks = New(bw + 1, bh + 1);
+    allBlocks   = New(bw, bh);
+
+    for (int by = 0; by < bh; by++)
+        for (int bx = 0; bx < bw; bx++)
+        {
+            int x0 = bx * SS_MASK_BLOCK, y0 = by * SS_MASK_BLOCK;
+            int x1 = MIN(x0 + SS_MASK_BLOCK, (int)width), y1 = MIN(y0 + SS_MASK_BLOCK, (int)height);
+            int n = 0;
+
+            for (int y = y0; y < y1; y++)
+                for (int x = x0; x < x1; x++)
+                    n += Get(x, y);
+
+            if (n)
+            {
+                anyBlocks->Set(bx, by);
+                grownBlocks->Set(bx, by);       grownBlocks->Set(bx + 1, by);
+                grownBlocks->Set(bx, by + 1);   grownBlocks->Set(bx + 1, by + 1);
+            }
+
+            // Blocks cut short by the edge never count as full
+            if (n == SS_MASK_BLOCK * SS_MASK_BLOCK)
+                allBlocks->Set(bx, by);
+        }
+
+    anyBlocks->Finish();
+    grownBlocks->Finish();
+    allBlocks->Finish();
+}
+
+//
+// Overlaps(other, dx, dy)
+//
+//  Do any set pixels coincide when the other mask's top-left
+//  is at (dx, dy) in this one? Each word of the other mask
+//  is shifted across the two words of this one it straddles.
+//
+//  Only the rows and words inside both occupied boxes are
+//  looked at. Before that, the block levels can settle it:
+//  a block of the right-hand mask lands in the block of the
+//  left-hand one it starts in and maybe the next, so if
+//  none of its grown blocks meet any of the other's there's
+//  no hit, and if two full blocks meet there surely is.
+//
+bool SS_CollisionMask::Overlaps(const SS_CollisionMask *other, int dx, int dy) const
+{
+    const SS_CollisionMask *a = this, *b = other;
+
+    // Keep the other mask to the right
+    if (dx < 0) {
+        a = other;  b = this;
+        dx = -dx;   dy = -dy;
+    }
+
+    // Where the occupied boxes meet, in a's pixels
+    int x0 = MAX((int)a->left, dx + b->left), x1 = MIN((int)a->right, dx + b->right);
+    int y0 = MAX((int)a->top, dy + b->top), y1 = MIN((int)a->bottom, dy + b->bottom);
+
+    if (x0 >= x1 || y0 >= y1)
+        return false;
+
+    if (a->anyBlocks && b->anyBlocks)
+    {
+        int bx = block_of(dx), by = block_of(dy);
+
+        if (!a->anyBlocks->Overlaps(b->grownBlocks, bx, by))
+            return false;
+
+        if (a->allBlocks->Overlaps(b->allBlocks, bx, by))
+            return true;
+    }
+
+    int k0 = dx >> 6, shift = dx & 63;
+    int j0 = (x0 - dx) >> 6, j1 = ((x1 - 1 - dx) >> 6) + 1;
+
+    for (int y = y0; y < y1; y++)
+    {
+        const Uint64 *arow = a->bits + y * a->words;
+        const Uint64 *brow = b->bits + (y - dy) * b->words;
+
+        for (int j = j0, k = k0 + j0; j < j1 && k < a->words; j++, k++)
+        {
+            Uint64 w = brow[j];
+            if (!w)
+                continue;
+
+            if (arow[k] & (w << shift))
+                return true;
+
+            if (shift && k + 1 < a->words && (arow[k + 1] & (w >> (64 - shift))))
+                return true;
+        }
+    }
+
+    return false;
+}
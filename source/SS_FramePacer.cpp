@@ -0,0 +1,192 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_FramePacer.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_FramePacer.h"
+
+#include "SS_Game.h"
+#include "SS_Profiler.h"
+
+// Work above this part of a frame is too close for vsync
+#define PACE_SLOW       0.90f
+
+// Work below this part of a frame is safe for vsync again
+#define PACE_FAST       0.70f
+
+// Weight of the newest frame in the average, as 1/n
+#define PACE_SMOOTH     16
+
+
+//--------------------------------------------------------------
+// SS_FramePacer
+//--------------------------------------------------------------
+
+SS_FramePacer::SS_FramePacer()
+{
+    mode        = SS_PACE_FREE;
+    preferred   = SS_PACE_FREE;
+    adaptive    = true;
+    adaptiveOK  = true;
+    target      = 0;
+    frameStart  = 0;
+    deadline    = 0;
+    work        = 0;
+    frame       = 0;
+    lastChange  = 0;
+}
+
+//
+// ModeName(mode)
+//
+const char* SS_FramePacer::ModeName(paceMode m)
+{
+    static const char *names[] = { "free", "vsync", "adaptive", "throttle" };
+    return names[m];
+}
+
+//
+// Start(mode, hz)
+// Begin pacing in the given mode with a fresh history
+//
+void SS_FramePacer::Start(paceMode m, float hz)
+{
+    DEBUGF(1, "[%p] SS_FramePacer::Start(%s, %.2f)\n", this, ModeName(m), hz);
+
+    SetTargetRate(hz);
+
+    work        = 0;
+    frame       = 0;
+    lastChange  = 0;
+    frameStart  = SS_Profiler::Now();
+    deadline    = frameStart;
+    changes.clear();
+
+    SetMode(m);
+}
+
+//
+// SetTargetRate(hz)
+// The frame rate to aim for, or 0 for none
+//
+void SS_FramePacer::SetTargetRate(float hz)
+{
+    target = (hz > 0) ? (Uint64)(1000000000.0 / hz) : 0;
+}
+
+//
+// SetMode(mode)
+// Use this mode from now on, adapting around it if allowed
+//
+void SS_FramePacer::SetMode(paceMode m)
+{
+    preferred = m;
+    ChangeMode(m);
+}
+
+//
+// ChangeMode(mode)
+//
+//  Set the swap interval for a mode and log the change. If
+//  the driver won't do adaptive vsync, throttle instead.
+//
+void SS_FramePacer::ChangeMode(paceMode m)
+{
+    if (SS_Game::HasGLContext())
+    {
+        switch (m)
+        {
+            case SS_PACE_VSYNC:
+                SS_Game::SyncVblank(1);
+                break;
+
+            case SS_PACE_ADAPTIVE:
+                if (SS_Game::SyncVblank(-1))
+                    break;
+
+                adaptiveOK = false;
+                m = SS_PACE_THROTTLE;
+                // fall through
+
+            default:
+                SS_Game::SyncVblank(0);
+                break;
+        }
+    }
+
+    if (m != mode)
+    {
+        DEBUGF(1, "[%p] SS_FramePacer: %s -> %s at frame %u (work %uus of %uus)\n",
+            this, ModeName(mode), ModeName(m), frame, WorkTime(), TargetTime());
+
+        if (changes.size() >= SS_PACE_LOG)
+            changes.erase(changes.begin());
+
+        SS_PaceChange c = { frame, mode, m, WorkTime(), TargetTime() };
+        changes.push_back(c);
+    }
+
+    mode        = m;
+    lastChange  = frame;
+    deadline    = SS_Profiler::Now();
+}
+
+//
+// Wait
+//
+//  Call at the top of each frame. When throttling, sleep until
+//  this frame is due. A frame more than a whole frame late
+//  starts a new cadence instead of trying to catch up.
+//
+void SS_FramePacer::Wait()
+{
+    Uint64 now = SS_Profiler::Now();
+
+    if (mode == SS_PACE_THROTTLE && target)
+    {
+        if (now < deadline)
+        {
+            SDL_DelayPrecise(deadline - now);
+            now = SS_Profiler::Now();
+        }
+
+        deadline = (now - deadline > target) ? now + target : deadline + target;
+    }
+
+    frameStart = now;
+}
+
+//
+// EndFrame(swapUS)
+//
+//  Call once the frame is displayed, with the time spent in
+//  the swap. Updates the average work time and, after the
+//  current mode has had its turn, moves between vsync and
+//  adaptive or throttled pacing.
+//
+void SS_FramePacer::EndFrame(Uint32 swapUS)
+{
+    Uint32  us = SS_Profiler::Since(frameStart);
+    float   w = (us > swapUS) ? (float)(us - swapUS) : 0.0f;
+
+    work += (w - work) / PACE_SMOOTH;
+    frame++;
+
+    if (!adaptive || preferred != SS_PACE_VSYNC || !target || frame - lastChange < SS_PACE_DWELL)
+        return;
+
+    float t = target / 1000.0f;
+
+    if (mode == SS_PACE_VSYNC)
+    {
+        if (work > t * PACE_SLOW)
+            ChangeMode(adaptiveOK ? SS_PACE_ADAPTIVE : SS_PACE_THROTTLE);
+    }
+    else if (work < t * PACE_FAST)
+        ChangeMode(SS_PACE_VSYNC);
+}
@@ -0,0 +1,219 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_FrameStats.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_FrameStats.h"
+
+#include <string.h>
+
+
+//--------------------------------------------------------------
+// SS_FrameHistogram
+//--------------------------------------------------------------
+
+void SS_FrameHistogram::Reset()
+{
+    memset(bins, 0, sizeof(bins));
+    count = 0;
+    sum = 0;
+    max = 0;
+}
+
+//
+// Add(us)
+//
+void SS_FrameHistogram::Add(Uint32 us)
+{
+    Uint32 bin = us / SS_HISTOGRAM_US;
+    if (bin >= SS_HISTOGRAM_BINS)
+        bin = SS_HISTOGRAM_BINS - 1;
+
+    bins[bin]++;
+    count++;
+    sum += us;
+    if (us > max) max = us;
+}
+
+//
+// Percentile(p)
+//
+//  The time that fraction p of the samples are at or under,
+//  to the upper edge of its bin. Never more than the max.
+//
+Uint32 SS_FrameHistogram::Percentile(float p) const
+{
+    if (count == 0)
+        return 0;
+
+    Uint32  want = (Uint32)(p * count + 0.999f), seen = 0;
+    if (want < 1) want = 1;
+
+    for (Uint32 b=0; b<SS_HISTOGRAM_BINS; b++)
+    {
+        seen += bins[b];
+        if (seen >= want)
+            return MIN((b + 1) * SS_HISTOGRAM_US, max);
+    }
+
+    return max;
+}
+
+
+#pragma mark -
+//--------------------------------------------------------------
+// SS_FrameStats
+//--------------------------------------------------------------
+
+SS_FrameStats::SS_FrameStats()
+{
+    budget = SS_FRAME_BUDGET;
+    Reset();
+}
+
+//
+// Reset
+// Forget everything and start timing from now
+//
+void SS_FrameStats::Reset()
+{
+    frames.Reset();
+    steps.Reset();
+    renders.Reset();
+    hitches.clear();
+    hitchCount = 0;
+    startNS = SS_Profiler::Now();
+}
+
+//
+// AddFrame(frameUS, renderUS, simFrame, prof)
+//
+//  Count one pass of the world's run loop. If it went over
+//  budget it's logged along with the profiler's breakdown,
+//  if there is one.
+//
+void SS_FrameStats::AddFrame(Uint32 frameUS, Uint32 renderUS, Uint32 simFrame, const SS_ProfileFrame *prof)
+{
+    frames.Add(frameUS);
+    renders.Add(renderUS);
+
+    if (frameUS <= budget)
+        return;
+
+    if (hitchCount++ >= SS_HITCH_LOG)
+        return;
+
+    SS_Hitch h;
+    h.frame         = frames.Count() - 1;
+    h.simFrame      = simFrame;
+    h.time          = (Uint32)((SS_Profiler::Now() - startNS) / 1000000);
+    h.frameTime     = frameUS;
+    h.renderTime    = renderUS;
+    h.hasProfile    = (prof != nullptr);
+
+    if (prof)
+        h.profile = *prof;
+    else
+        memset(&h.profile, 0, sizeof(SS_ProfileFrame));
+
+    hitches.push_back(h);
+}
+
+//
+// Write(path)
+// Save as JSON if the name ends in ".json", otherwise CSV
+//
+bool SS_FrameStats::Write(const char *path) const
+{
+    DEBUGF(1, "[%p] SS_FrameStats::Write(\"%s\")\n", this, path);
+
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    size_t len = strlen(path);
+    if (len > 5 && !SDL_strcasecmp(path + len - 5, ".json"))
+        WriteJSON(file);
+    else
+        WriteCSV(file);
+
+    fclose(file);
+    return true;
+}
+
+//
+// WriteCSV(file)
+//
+//  A summary table (times in microseconds), a blank line,
+//  then the hitch log with one column per profiler stage.
+//
+void SS_FrameStats::WriteCSV(FILE *file) const
+{
+    const SS_FrameHistogram *h[3] = { &frames, &steps, &renders };
+    const char *names[3] = { "frame", "step", "render" };
+
+    fprintf(file, "series,count,mean,p50,p95,p99,max\n");
+    for (int i=0; i<3; i++)
+        fprintf(file, "%s,%u,%u,%u,%u,%u,%u\n", names[i],
+            h[i]->Count(), h[i]->Mean(), h[i]->Percentile(0.50f),
+            h[i]->Percentile(0.95f), h[i]->Percentile(0.99f), h[i]->Max());
+
+    fprintf(file, "\nhitch,frame,sim_frame,time_ms,frame_us,render_us");
+    for (int s=0; s<SS_STAGE_COUNT; s++)
+        fprintf(file, ",stage_%s", SS_Profiler::StageName(s));
+    fprintf(file, "\n");
+
+    for (size_t i=0; i<hitches.size(); i++)
+    {
+        const SS_Hitch &e = hitches[i];
+        fprintf(file, "%u,%u,%u,%u,%u,%u", (Uint32)i, e.frame, e.simFrame, e.time, e.frameTime, e.renderTime);
+        for (int s=0; s<SS_STAGE_COUNT; s++)
+        {
+            if (e.hasProfile)
+                fprintf(file, ",%u", e.profile.stage[s]);
+            else
+                fprintf(file, ",");
+        }
+        fprintf(file, "\n");
+    }
+}
+
+//
+// WriteJSON(file)
+//
+void SS_FrameStats::WriteJSON(FILE *file) const
+{
+    const SS_FrameHistogram *h[3] = { &frames, &steps, &renders };
+    const char *names[3] = { "frame", "step", "render" };
+
+    fprintf(file, "{\n  \"budget_us\": %u,\n  \"hitches\": %u,\n", budget, hitchCount);
+
+    for (int i=0; i<3; i++)
+        fprintf(file, "  \"%s\": { \"count\": %u, \"mean\": %u, \"p50\": %u, \"p95\": %u, \"p99\": %u, \"max\": %u },\n",
+            names[i], h[i]->Count(), h[i]->Mean(), h[i]->Percentile(0.50f),
+            h[i]->Percentile(0.95f), h[i]->Percentile(0.99f), h[i]->Max());
+
+    fprintf(file, "  \"hitch_log\": [");
+    for (size_t i=0; i<hitches.size(); i++)
+    {
+        const SS_Hitch &e = hitches[i];
+        fprintf(file, "%s\n    { \"frame\": %u, \"sim_frame\": %u, \"time_ms\": %u, \"frame_us\": %u, \"render_us\": %u",
+            i ? "," : "", e.frame, e.simFrame, e.time, e.frameTime, e.renderTime);
+
+        if (e.hasProfile)
+        {
+            fprintf(file, ", \"stages\": {");
+            for (int s=0; s<SS_STAGE_COUNT; s++)
+                fprintf(file, "%s \"%s\": %u", s ? "," : "", SS_Profiler::StageName(s), e.profile.stage[s]);
+            fprintf(file, " }");
+        }
+
+        fprintf(file, " }");
+    }
+    fprintf(file, "%s]\n}\n", hitches.empty() ? "" : "\n  ");
+}
@@ -22,22 +22,9 @@
 #include <SDL_opengl.h>
 
 #include <string.h>
+#include <stdlib.h>
 
 
-//
-// Get headers to allow VSync
-//
-#ifdef WIN32
-
-typedef void (APIENTRY *SWAP_PROC)(int interval);
-
-#elif defined(__APPLE__)
-
-#include <OpenGL/CGLCurrent.h>
-#include <OpenGL/OpenGL.h>
-
-#endif
-
 #ifndef SS_VIDEO_W
   #define SS_VIDEO_W 1920
 #endif
@@ -50,11 +37,19 @@ typedef void (APIENTRY *SWAP_PROC)(int interval);
 #ifndef SS_FULLSCREEN
   #define SS_FULLSCREEN false
 #endif
+#ifndef SS_HEADLESS
+  #define SS_HEADLESS false
+#endif
+#ifndef SS_OFFSCREEN
+  #define SS_OFFSCREEN 0
+#endif
 
 int     ss_video_w = SS_VIDEO_W;
 int     ss_video_h = SS_VIDEO_H;
 bool    ss_vsync = SS_VSYNC;
 bool    ss_fullscreen = SS_FULLSCREEN;
+bool    ss_headless = SS_HEADLESS;
+int     ss_offscreen = SS_OFFSCREEN;    // headless GL: 0 = none, 1 = hardware, 2 = software
 
 //--------------------------------------------------------------
 // SS_Game
@@ -104,6 +99,19 @@ void SS_Game::LoadConfig()
     ss_video_h = dataFile.GetInteger("Height");
     ss_fullscreen = dataFile.GetBoolean("Fullscreen");
     ss_vsync = dataFile.GetBoolean("Vsync");
+
+    // Older config files have no Headless token
+    if (*dataFile.GetString("Headless"))
+        ss_headless = dataFile.GetBoolean("Headless");
+
+    if (*dataFile.GetString("Offscreen"))
+        ss_offscreen = dataFile.GetInteger("Offscreen");
+
+    // A render farm can force these from the environment
+    if (getenv("SS_HEADLESS"))
+        ss_headless = (atoi(getenv("SS_HEADLESS")) != 0);
+    if (getenv("SS_OFFSCREEN"))
+        ss_offscreen = atoi(getenv("SS_OFFSCREEN"));
 }
 
 //
@@ -118,9 +126,18 @@ void SS_Game::Init()
     for (int i=SS_MAX_WORLDS;i--;)
         worlds[i] = nullptr;
 
-    InitTrigonometry();             // Prepare sine and cosine arrays
-    InitScreen();                   // Prepare the screen / window
-    SS_Sound::InitAudioMixer(64);   // Start up the audio system
+    InitTrigonometry();                 // Prepare sine and cosine arrays
+
+    if (ss_headless) {
+        if (ss_offscreen)
+            InitOffscreen();            // GL context with no visible window
+        else
+            InitHeadless();             // Events and timers only
+    }
+    else {
+        InitScreen();                   // Prepare the screen / window
+        SS_Sound::InitAudioMixer(64);   // Start up the audio system
+    }
 
     // Send all printed output to a file
     SS_Folder::cdAppFolder();
@@ -167,6 +184,15 @@ void SS_Game::InitScreen()
     SDL_SetWindowGrab(ss_window, SDL_TRUE);     // Keep mouse pointer in window
     SDL_ShowCursor(SDL_DISABLE);                // Hide the system pointer
 
+    InitGLState();
+}
+
+//
+// InitGLState
+// Set up OpenGL for flat 2D drawing
+//
+void SS_Game::InitGLState()
+{
     //
     // Turn off 3D features
     //
@@ -215,6 +241,45 @@ void SS_Game::InitScreen()
 
 }
 
+//
+// InitHeadless
+// Start SDL with no window, GL context, or audio device.
+// Worlds still get input, collisions, Process and Animate,
+// but Render draws nothing and no textures are uploaded.
+//
+void SS_Game::InitHeadless()
+{
+    if ( !SDL_Init(SDL_INIT_EVENTS) )
+        throw "Couldn't initialize SDL: %s\n";
+}
+
+//
+// InitOffscreen
+//
+//  Headless, but with a GL context on a hidden window so
+//  worlds can draw into an SS_RenderTarget and read the
+//  pixels back. Mode 2 asks for a software renderer
+//  (e.g. llvmpipe or Apple's) for machines with no GPU.
+//
+void SS_Game::InitOffscreen()
+{
+    if ( !SDL_Init(SDL_INIT_VIDEO) )
+        throw "Couldn't initialize SDL: %s\n";
+
+    if (ss_offscreen == 2)
+        SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 0);
+
+    ss_window = SDL_CreateWindow("SimpleSprite", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, ss_video_w, ss_video_h, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!ss_window)
+        throw "Can't create Window: %s\n";
+
+    ss_glcontext = SDL_GL_CreateContext(ss_window);
+    if (!ss_glcontext)
+        throw "Can't create GL context: %s\n";
+
+    InitGLState();
+}
+
 //
 // InitTrigonometry
 //
@@ -234,24 +299,29 @@ void SS_Game::InitTrigonometry()
 //
 // SyncVblank(interval)
 //
-// Tell OpenGL to synchronize to vertical blanking
+//  Tell OpenGL to synchronize to vertical blanking. An
+//  interval of -1 asks for adaptive vsync, which swaps late
+//  frames immediately. Returns false if the driver refused.
 //
-void SS_Game::SyncVblank(long sync)
+bool SS_Game::SyncVblank(long sync)
 {
-#ifdef WIN32
-
-    SWAP_PROC wglSwapIntervalEXT = (SWAP_PROC) wglGetProcAddress("wglSwapIntervalEXT");
-    if (wglSwapIntervalEXT != nullptr) wglSwapIntervalEXT(sync);
-
-#elif defined(__APPLE__)
-
-    CGLContextObj   ctx = CGLGetCurrentContext();
-    GLint           interval = sync;
+    return SDL_GL_SetSwapInterval((int)sync);
+}
 
-    // tell OpenGL to synchronize with screen refresh
-    CGLSetParameter(ctx, kCGLCPSwapInterval, &interval);
+//
+// RefreshRate
+// The refresh rate of the window's display, or 60 if unknown
+//
+float SS_Game::RefreshRate()
+{
+    if (ss_window)
+    {
+        const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(ss_window));
+        if (mode && mode->refresh_rate > 0)
+            return mode->refresh_rate;
+    }
 
-#endif
+    return 60.0f;
 }
 
 //
@@ -30,6 +30,21 @@ void SS_ItemGroup::Init()
     Clear();
 }
 
+//
+// ~SS_ItemGroup
+// Members that outlive the group forget its nodes
+//
+SS_ItemGroup::~SS_ItemGroup()
+{
+    SS_Collider     *item;
+    SS_ColliderIterator itr = GetIterator();
+    while ((item = itr.NextItem()))
+    {
+        item->groupNode = nullptr;
+        item->group = nullptr;
+    }
+}
+
 
 //
 // SetWorld
@@ -114,7 +129,7 @@ void SS_ItemGroup::AddItem(SS_Collider *item)
         height = item->height;
 
     item->Retain("Item In Group");
-    Append(item);
+    item->groupNode = Append(item);
 
     //
     // Next, if this group is in a layer already then
@@ -173,10 +188,17 @@ void SS_ItemGroup::Process()
 
         if (item->removeFlag)
         {
+            // Disposal touches the collision lists,
+            // so in a parallel pass leave it for later
+            if (world->IsDeferringNodes()) {
+                itr.Next();
+                continue;
+            }
+
             // Dispose the node and the sub-item.
             // (Also moves the iterator forward)
             // The collider node will be removed during destruction.
-            Dispose(itr);
+            DisposeMember(itr);
         }
         else {
             item->_Process();
@@ -186,6 +208,52 @@ void SS_ItemGroup::Process()
 }
 
 
+//
+// FinishParallel
+// Dispose removed members and settle collision nodes
+//
+void SS_ItemGroup::FinishParallel()
+{
+    SS_Collider::FinishParallel();
+
+    SS_Collider *item;
+    SS_ColliderIterator itr = GetIterator();
+    while (itr.IsValid())
+    {
+        item = itr.Item();
+
+        if (item->removeFlag)
+            DisposeMember(itr);
+        else {
+            item->FinishParallel();
+            itr.Next();
+        }
+    }
+}
+
+
+//
+// DisposeMember(iter)
+//
+//  Unlink a member by its own node, move the iterator on,
+//  then delete the member. The node is gone before the
+//  member's destructor runs, so it isn't removed twice.
+//
+void SS_ItemGroup::DisposeMember(SS_ColliderIterator &itr)
+{
+    SS_Collider     *item = itr.Item();
+    SS_ColliderNode *node = itr.m_node;
+
+    itr.Next();
+
+    SS_ASSERT(item->groupNode == node);
+    item->groupNode = nullptr;
+    Remove(node);
+
+    delete item;
+}
+
+
 //
 // Animate
 // Animate every sprite (and group) in the group
@@ -248,6 +316,31 @@ void SS_ItemGroup::Render(const SScolorb &inTint)
 }
 
 
+//
+// BeginInterpolation / EndInterpolation
+// Interpolate the group and every item in it
+//
+void SS_ItemGroup::BeginInterpolation(float alpha)
+{
+    SS_Collider::BeginInterpolation(alpha);
+
+    SS_Collider     *item;
+    SS_ColliderIterator itr = GetIterator();
+    while ((item = itr.NextItem()))
+        item->BeginInterpolation(alpha);
+}
+
+void SS_ItemGroup::EndInterpolation()
+{
+    SS_Collider::EndInterpolation();
+
+    SS_Collider     *item;
+    SS_ColliderIterator itr = GetIterator();
+    while ((item = itr.NextItem()))
+        item->EndInterpolation();
+}
+
+
 //
 // IsOnScreen
 // Determine if any sub-sprite is on-screen
@@ -12,10 +12,36 @@
 #include "SS_ItemList.h"
 #include "SS_LayerItem.h"
 
+//
+// Enlist(item, front)
+// Add an item and record its node with the item
+//
+SS_ItemNode* SS_ItemList::Enlist(SS_LayerItem *item, bool front)
+{
+    SS_ItemNode *node = front ? Prepend(item) : Append(item);
+    item->AddNode(node);
+    return node;
+}
+
+//
+// Delist(item)
+// Unlink an item by its recorded node, without a search
+//
+bool SS_ItemList::Delist(SS_LayerItem *item)
+{
+    SS_ItemNode *node = item->NodeIn(this);
+    if (!node)
+        return false;
+
+    item->DropNode(node);
+    Remove(node);
+    return true;
+}
+
 void SS_ItemList::RemoveItem(SS_LayerItem *item)
 {
-    Remove(item);
-    item->Release();
+    if (Delist(item))
+        item->Release();
 }
 
 void SS_ItemList::ReleaseAll()
@@ -28,3 +54,14 @@ void SS_ItemList::ReleaseAll()
     Clear();
 }
 
+//
+// Clear
+// Forget every node, then delete them
+//
+void SS_ItemList::Clear()
+{
+    for (SS_ItemNode *node = m_head; node; node = node->m_next)
+        node->m_data->DropNode(node);
+
+    TLinkedList<SS_LayerItem*>::Clear();
+}
@@ -14,6 +14,8 @@
 #include "SS_Types.h"
 #include "SS_World.h"
 #include "SS_Game.h"
+#include "SS_Snapshot.h"
+#include "SS_Workers.h"
 
 
 //--------------------------------------------------------------
@@ -99,6 +101,9 @@ SS_Layer::~SS_Layer()
 {
     DEBUGF(1, "[%p] ~SS_Layer() DESTRUCTOR\n", this);
 
+    // The visible list holds no references of its own
+    visibleList.Clear();
+
     RemoveSelf();
 }
 
@@ -146,8 +151,10 @@ void SS_Layer::SetWorld(SS_World *w)
 
     SS_LayerItem    *item;
     SS_ItemIterator itr = GetIterator();
-    while ((item = itr.NextItem()))
+    while ((item = itr.NextItem())) {
         item->SetWorld(w);
+        item->ScheduleTimers();
+    }
 }
 
 //
@@ -165,7 +172,7 @@ void SS_Layer::AddItem(SS_LayerItem *item)
     if (item->RefCount() > 1)
         printf("Over 1\n");
 
-    Append(item);
+    Enlist(item);
 }
 
 //
@@ -183,26 +190,104 @@ void SS_Layer::PrependItem(SS_LayerItem *item)
     if (item->RefCount() > 1)
         printf("Over 1\n");
 
-    Prepend(item);
+    Enlist(item, true);
 }
 
 //
 // Process
 // Tell all the items in the layer to Process
 //
+//  Items flagged SS_PURE are only collected here, and then
+//  updated together on the worker pool once the others are
+//  done. Their updates have no side effects, so the order
+//  makes no difference.
+//
+//  This still visits every item each step, for removals,
+//  SS_AUTOMOVE, interpolation state and collision nodes.
+//  Items on the world's timer wheel only skip their own
+//  interval checks here; RunTimers calls them when due.
+//
 void SS_Layer::Process()
 {
+    bool            parallel = SS_WorkerPool::Shared()->ThreadCount() > 0;
+
+    pureItems.clear();
+
     SS_LayerItem    *item;
     SS_ItemIterator itr = GetIterator();
     while ((item = itr.NextItem()))
     {
-        if (item->removeFlag)
-            item->RemoveSelf();
+        if (item->removeFlag) {
+            if (!world->IsDeferringNodes())     // parallel: FinishParallel removes it
+                item->RemoveSelf();
+        }
+        else if (parallel && item->Flags(SS_PURE))
+            pureItems.push_back(item);
         else {
             item->_Process();
             item->_Animate();
         }
     }
+
+    if (!pureItems.empty())
+        ProcessPureItems();
+}
+
+//
+// process_pure
+// Worker pool entry point for one SS_PURE item
+//
+void SS_Layer::process_pure(void *l, Uint32 i)
+{
+    SS_LayerItem *item = ((SS_Layer*)l)->pureItems[i];
+    item->_Process();
+    item->_Animate();
+}
+
+//
+// ProcessPureItems
+//
+//  Update the collected SS_PURE items in chunks across the
+//  worker pool. Collision node updates are held back during
+//  the pass and then done in list order. If this layer is
+//  itself part of a parallel layer pass the layer join does
+//  that instead.
+//
+void SS_Layer::ProcessPureItems()
+{
+    Uint32  count = (Uint32)pureItems.size();
+    bool    join = !world->IsDeferringNodes();
+
+    if (join) world->SetDeferringNodes(true);
+
+    SS_WorkerPool::Shared()->Run(count, process_pure, this, SS_PARALLEL_GRAIN);
+
+    if (join)
+    {
+        world->SetDeferringNodes(false);
+        for (Uint32 i = 0; i < count; i++)
+            pureItems[i]->FinishParallel();
+    }
+}
+
+//
+// FinishParallel
+//
+//  After a parallel Process, remove dead items and let the
+//  rest update their collision nodes, in list order, so the
+//  result is the same however the threads were scheduled.
+//
+void SS_Layer::FinishParallel()
+{
+    SS_LayerItem    *item;
+    SS_ItemIterator itr = GetIterator();
+    while ((item = itr.NextItem()))
+    {
+        if (item->removeFlag)
+            item->RemoveSelf();
+        else
+            item->FinishParallel();
+    }
 }
 
 //
@@ -233,47 +318,95 @@ void SS_Layer::Render()
 
     SS_LayerItem    *item;
     SS_ItemIterator itr = visibleList.GetIterator();
-    while ((item = itr.NextItem()))
-        item->Render(tint);
+
+    //
+    // With a fixed timestep draw each item part of the
+    // way between its last two simulated states
+    //
+    if (world->IsInterpolating())
+    {
+        float alpha = world->InterpolationAlpha();
+        while ((item = itr.NextItem()))
+        {
+            item->BeginInterpolation(alpha);
+            item->Render(tint);
+            item->EndInterpolation();
+        }
+    }
+    else
+    {
+        while ((item = itr.NextItem()))
+            item->Render(tint);
+    }
 }
 
 //
 // RemoveItem
-// Remove a single item from the layer
-// EXPENSIVE! DO NOT USE!
+// Remove and release a single item, by the nodes it keeps
 //
 void SS_Layer::RemoveItem(SS_LayerItem *item)
 {
     DEBUGF(1, "[%p] SS_Layer::RemoveSprite(%p)\n", this, item);
 
-    visibleList.Remove(item);
+    visibleList.Delist(item);
     SS_ItemList::RemoveItem(item);
 }
 
 //
 // DisposeItem
 //
-//  Locate and dispose a single item in the layer.
-//  You probably shouldn't use this method, but here it is.
-//
-//  SLOW - Uses a Linked list search to find the item
-//
-//  TODO: Save and use the item's node instead if removal of this kind is needed,
-//  or Kill() the item and it will be removed during processing.
+//  Dispose a single item in the layer. The item leaves
+//  every list it's in as it's deleted. Kill() is still the
+//  better way, leaving the item to be removed in Process.
 //
 void SS_Layer::DisposeItem(SS_LayerItem *item)
 {
     DEBUGF(1, "[%p] SS_Layer::DisposeItem(%p)\n", this, item);
 
-    visibleList.Remove(item);
     delete item;
 }
 
 //
-// PrepareMatrix
-// Prepare the projection matrix, either zooming it or not
+// Snapshot(snap)
 //
-void SS_Layer::PrepareMatrix()
+//  Record every visible item for a pipelined render. If any
+//  item can't be captured the whole layer is left live, to be
+//  rendered from the layer itself under the world lock.
+//
+bool SS_Layer::Snapshot(SS_RenderSnapshot *snap)
+{
+    bool    captured = true;
+
+    snap->BeginLayer(this);
+
+    SS_LayerItem    *item;
+    SS_ItemIterator itr = visibleList.GetIterator();
+    while ((item = itr.NextItem()))
+        if (!item->Snapshot(snap, tint)) {
+            captured = false;
+            break;
+        }
+
+    snap->EndLayer(!captured);
+    return captured;
+}
+
+//
+// SnapshotLive(snap)
+// For layers that draw themselves and can't be captured
+//
+bool SS_Layer::SnapshotLive(SS_RenderSnapshot *snap)
+{
+    snap->BeginLayer(this);
+    snap->EndLayer(true);
+    return false;
+}
+
+//
+// GetProjection
+// The area of the world the layer shows, either zoomed or not
+//
+void SS_Layer::GetProjection(float *outX, float *outY, float *outW, float *outH) const
 {
     float   x, y, w, h;
 
@@ -295,6 +428,20 @@ void SS_Layer::PrepareMatrix()
         h = world->ZoomHeight();
     }
 
+    *outX = x; *outY = y;
+    *outW = w; *outH = h;
+}
+
+//
+// PrepareMatrix
+// Prepare the projection matrix, either zooming it or not
+//
+void SS_Layer::PrepareMatrix()
+{
+    float   x, y, w, h;
+
+    GetProjection(&x, &y, &w, &h);
+
     gl_bind_texture(0);
 
     glMatrixMode(GL_PROJECTION);
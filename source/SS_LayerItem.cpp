@@ -45,6 +45,10 @@ SS_LayerItem::~SS_LayerItem()
 #endif
 
     RemoveSelf();
+
+    // Not in a layer, but make sure
+    if (moveTimer.wheel) moveTimer.wheel->Cancel(&moveTimer);
+    if (animTimer.wheel) animTimer.wheel->Cancel(&animTimer);
 }
 
 
@@ -62,11 +66,18 @@ void SS_LayerItem::Init()
     world           = nullptr;
     layer           = nullptr;
     group           = nullptr;
-//  mainNode        = nullptr;
+    groupNode       = nullptr;
+    nodeArray.block_size = 4;   // a layer and its visible list, usually
 
     oldW            = 0.0f;
     oldH            = 0.0f;
 
+    // Interpolation state
+    lastx           = 0.0f;
+    lasty           = 0.0f;
+    lastrot         = 0.0f;
+    lastStep        = 0;
+
     // Size
     width           = 0.0f;
     height          = 0.0f;
@@ -89,11 +100,18 @@ void SS_LayerItem::Init()
     animInterval    = 20;
     lastAnimTime    = 0;
     animProc        = defaultAnimProc;
+    animTimer.owner = this;
+    animTimer.kind  = SS_TIMER_ANIMATE;
 
     // Motion behavior
     moveInterval    = 20;
     lastMoveTime    = 0;
     moveProc        = nullptr;
+    moveTimer.owner = this;
+    moveTimer.kind  = SS_TIMER_MOVE;
+
+    // Drawn here so pooled timers never call rand()
+    startPhase      = (Uint16)RANDINT(0, 0xFFFF);
 
     // Tint
     SetTint(0xFF, 0xFF, 0xFF, 0xFF);
@@ -152,6 +170,8 @@ void SS_LayerItem::SetLayer(SS_Layer *l)
     DEBUGF(1, "[%p] SS_LayerItem::SetLayer(%p)\n", this, l);
 
     SetWorld((layer = l) ? l->World() : nullptr);
+
+    ScheduleTimers();
 }
 
 
@@ -184,6 +204,7 @@ const SS_LayerItem& SS_LayerItem::operator=(const SS_LayerItem &src)
         world           = nullptr;
         layer           = nullptr;
         group           = nullptr;
+        groupNode       = nullptr;
 
         oldW            = 0.0f;
         oldH            = 0.0f;
@@ -196,6 +217,8 @@ const SS_LayerItem& SS_LayerItem::operator=(const SS_LayerItem &src)
         lastMoveTime    = 0;
         lastAnimTime    = 0;
 
+        lastStep        = 0;
+
         // Some are copied directly
         animProc        = src.animProc;
         animFirst       = src.animFirst;
@@ -300,25 +323,139 @@ void SS_LayerItem::Tokenize(SS_FlatFile &dataFile)
 //
 // RemoveSelf
 //
-// Unlink this item from its group's or layer's linked list
-//
-// TODO: Give layeritems a list of node references that allow it
-//  to track its membership in all lists. This method will then
-//  simply remove the item from all lists.
+// Unlink this item from its group's list and from every
+// item list it's in, using the nodes it keeps. Nothing
+// is searched, so this takes the same time in any list.
 //
 void SS_LayerItem::RemoveSelf() // aka "Unlink()"
 {
     DEBUGF(1, "[%p] SS_LayerItem::RemoveSelf()\n", this);
 
+    CheckNodes();
+
     if (group) {
-        group->Remove(dynamic_cast<SS_Collider*>(this));
+        if (groupNode) {
+            group->Remove(groupNode);
+            groupNode = nullptr;
+        }
         SetGroup(nullptr);
     }
-    else if (layer) {
-//      layer->visibleList.Remove(this);
-        layer->Remove(this);
+    else if (layer)
         SetLayer(nullptr);
+
+    Unlist();
+}
+
+//
+// MoveToLayer(layer)
+//
+//  Move this item to the end of another layer. Its node
+//  moves with it, so the layer's reference carries over.
+//
+void SS_LayerItem::MoveToLayer(SS_Layer *l)
+{
+    DEBUGF(1, "[%p] SS_LayerItem::MoveToLayer(%p)\n", this, l);
+
+    SS_ASSERT(group == nullptr);
+
+    SS_ItemNode *node = layer ? NodeIn(layer) : nullptr;
+
+    if (!node) {
+        l->AddItem(this);
+        return;
     }
+
+    if (l == layer)
+        return;
+
+    layer->visibleList.Delist(this);
+    node->Migrate(l);
+
+    // Another world has its own colliders
+    if (l->World() != world)
+        SetLayer(nullptr);
+
+    SetLayer(l);
+
+    CheckNodes();
+}
+
+//
+// AddNode / DropNode
+// Keep track of the list nodes that refer to this item
+//
+void SS_LayerItem::AddNode(SS_ItemNode *node)
+{
+    SS_ASSERT(node->m_data == this);
+    SS_ASSERT(NodeIn(node->m_container) == nullptr);
+
+    nodeArray.Append(node);
+}
+
+void SS_LayerItem::DropNode(SS_ItemNode *node)
+{
+    for (Uint32 i = nodeArray.Size(); i--;)
+        if (nodeArray[i] == node) {
+            nodeArray.Delete(i);
+            return;
+        }
+
+    SS_ASSERT(!"Dropped a node the item didn't have");
+}
+
+//
+// NodeIn(list)
+// The node that holds this item in the given list
+//
+SS_ItemNode* SS_LayerItem::NodeIn(const TLinkedList<SS_LayerItem*> *list) const
+{
+    for (Uint32 i = 0; i < nodeArray.Size(); i++)
+        if (nodeArray[i]->m_container == list)
+            return nodeArray[i];
+
+    return nullptr;
+}
+
+//
+// Unlist
+// Leave every item list this item is in
+//
+void SS_LayerItem::Unlist()
+{
+    while (nodeArray.Size())
+    {
+        SS_ItemNode *node = nodeArray[nodeArray.Size() - 1];
+        nodeArray.PopLast();
+        node->m_container->Remove(node);
+    }
+}
+
+//
+// CheckNodes
+//
+//  With SS_ASSERT_ON, make sure every recorded node still
+//  holds this item, is in a list, and is the only one in
+//  that list.
+//
+void SS_LayerItem::CheckNodes() const
+{
+#ifdef SS_ASSERT_ON
+    for (Uint32 i = 0; i < nodeArray.Size(); i++)
+    {
+        const SS_ItemNode *node = nodeArray[i];
+        SS_ASSERT(node->m_data == this);
+        SS_ASSERT(node->m_container != nullptr);
+
+        for (Uint32 j = i + 1; j < nodeArray.Size(); j++)
+            SS_ASSERT(nodeArray[j]->m_container != node->m_container);
+    }
+
+    if (groupNode) {
+        SS_ASSERT(group != nullptr);
+        SS_ASSERT(groupNode->m_container == group);
+        SS_ASSERT((const SS_LayerItem*)groupNode->m_data == this);
+    }
+#endif
 }
 
 
@@ -657,6 +794,7 @@ void SS_LayerItem::SetMoveProc(spriteProcPtr proc)
 
     lastMoveTime = 0;
     moveProc = proc;
+    ScheduleTimer(&moveTimer);
 }
 
 
@@ -668,6 +806,7 @@ void SS_LayerItem::SetProcessInterval(Uint32 ms)
     moveInterval = 0;
     lastMoveTime = world ? world->GetWorldTime() + RANDINT(0, ms) : 0;
     moveInterval = ms;
+    ScheduleTimer(&moveTimer);
 }
 
 //
@@ -676,6 +815,18 @@ void SS_LayerItem::SetProcessInterval(Uint32 ms)
 void SS_LayerItem::PrimeProcessor()
 {
     lastMoveTime = world ? world->GetWorldTime() + RANDINT(0, moveInterval) : 0;
+    ScheduleTimer(&moveTimer);
+}
+
+//
+// SetAnimInterval(ms)
+//
+void SS_LayerItem::SetAnimInterval(Uint32 ms)
+{
+    animInterval = 0;
+    lastAnimTime = 0;
+    animInterval = ms;
+    ScheduleTimer(&animTimer);
 }
 
 //
@@ -687,6 +838,66 @@ void SS_LayerItem::SetAnimateProc(spriteProcPtr proc)
 
     lastAnimTime = 0;
     animProc = proc;
+    ScheduleTimer(&animTimer);
+}
+
+//
+// UsesTimers
+//
+//  Items directly in a processing layer are run by the world's
+//  timer wheel. Group members, and the items of layers that run
+//  their own (tiles, the GUI and its gadgets), are timed by their
+//  container, which runs them as it always has.
+//
+bool SS_LayerItem::UsesTimers() const
+{
+    return world && layer && !group && layer->RunsItemTimers();
+}
+
+//
+// ScheduleTimer(timer)
+//
+//  Put the move or animate timer on the world's wheel for the
+//  next time it's due, or take it off if the item doesn't use
+//  timers (any more). A last time of 0 means due right away.
+//
+void SS_LayerItem::ScheduleTimer(SS_Timer *t)
+{
+    Uint32  interval = (t == &moveTimer) ? moveInterval : animInterval;
+    Uint32  last = (t == &moveTimer) ? lastMoveTime : lastAnimTime;
+
+    if (!interval || !UsesTimers())
+    {
+        if (t->wheel) t->wheel->Cancel(t);
+        return;
+    }
+
+    world->Timers()->Schedule(t, last ? last + interval : world->ticks);
+}
+
+//
+// RunTimer(timer)
+//
+//  Call Process or Animate for a timer that came due, and set
+//  the time it last ran just as _Process and _Animate do. The
+//  caller reschedules it; this only touches the item, so pure
+//  items can run on the worker pool. The first-run jitter comes
+//  from the item's startPhase, not rand().
+//
+void SS_LayerItem::RunTimer(SS_Timer *t)
+{
+    Uint32 now = world->ticks;
+
+    if (t == &moveTimer)
+    {
+        Process();
+        lastMoveTime = lastMoveTime ? now : now + FirstDelay(moveInterval);
+    }
+    else
+    {
+        Animate();
+        lastAnimTime = lastAnimTime ? now : now + FirstDelay(animInterval);
+    }
 }
 
 
@@ -759,17 +970,20 @@ void SS_LayerItem::PushAndPrepareMatrix()
 //
 void SS_LayerItem::_Process()
 {
+    if (world->IsInterpolating())
+        SaveMotionState();
+
     if (Flags(SS_AUTOMOVE) && world->fireAuto)
         AutoMove();
 
-    if (moveInterval && (world->ticks - lastMoveTime >= moveInterval))
+    if (moveInterval && !moveTimer.IsScheduled() && (world->ticks - lastMoveTime >= moveInterval))
     {
         Process();
 
         if (lastMoveTime)
             lastMoveTime = world->ticks;
         else
-            lastMoveTime = world->ticks + RANDINT(0, moveInterval);
+            lastMoveTime = world->ticks + FirstDelay(moveInterval);
     }
 }
 
@@ -791,7 +1005,7 @@ void SS_LayerItem::Process()
 //
 void SS_LayerItem::_Animate()
 {
-    if (animInterval) {
+    if (animInterval && !animTimer.IsScheduled()) {
         if (world->ticks - lastAnimTime >= animInterval)
         {
             Animate();
@@ -799,7 +1013,7 @@ void SS_LayerItem::_Animate()
             if (lastAnimTime)
                 lastAnimTime = world->ticks;
             else
-                lastAnimTime = world->ticks + RANDINT(0, animInterval);
+                lastAnimTime = world->ticks + FirstDelay(animInterval);
         }
     }
 }
@@ -849,6 +1063,58 @@ void SS_LayerItem::BounceOff(SS_LayerItem * const item)
     item->SetVelocity(h * 0.9f, v * 0.9f);
 }
 
+//
+// SaveMotionState
+// Remember the state going into a fixed sim step
+//
+void SS_LayerItem::SaveMotionState()
+{
+    lastx = xpos;
+    lasty = ypos;
+    lastrot = rotation;
+    lastStep = world->SimFrame() + 1;
+}
+
+//
+// BeginInterpolation(alpha)
+//
+//  Move the item part of the way from its state before
+//  the last sim step to its current state, for rendering.
+//  Items that weren't stepped last time are left as-is.
+//  Rotation takes the shortest way around.
+//
+void SS_LayerItem::BeginInterpolation(float alpha)
+{
+    heldx = xpos;
+    heldy = ypos;
+    heldrot = rotation;
+    heldindex = rotindex;
+
+    if (lastStep == world->SimFrame())
+    {
+        float dr = rotation - lastrot;
+        if (dr > 180.0f) dr -= 360.0f;
+        else if (dr < -180.0f) dr += 360.0f;
+
+        xpos = lastx + (xpos - lastx) * alpha;
+        ypos = lasty + (ypos - lasty) * alpha;
+        rotation = lastrot + dr * alpha;
+        rotindex = SS_ROTINDEX(rotation);
+    }
+}
+
+//
+// EndInterpolation
+// Restore the actual state after rendering
+//
+void SS_LayerItem::EndInterpolation()
+{
+    xpos = heldx;
+    ypos = heldy;
+    rotation = heldrot;
+    rotindex = heldindex;
+}
+
 //
 // SendCommand
 //
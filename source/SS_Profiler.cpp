@@ -0,0 +1,244 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Profiler.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_Profiler.h"
+
+#include "SS_Game.h"
+
+#include <string.h>
+
+
+//--------------------------------------------------------------
+// SS_Profiler
+//--------------------------------------------------------------
+
+SS_Profiler::SS_Profiler()
+{
+    for (int i=SS_PROFILE_FRAMES; i--;) {
+        ring[i].seq = 0;
+        memset(&ring[i].data, 0, sizeof(SS_ProfileFrame));
+    }
+
+    for (int s=SS_STAGE_COUNT; s--;)
+        accum[s] = 0;
+
+    written     = 0;
+    layerCount  = 0;
+    frameStart  = Now();
+    enabled     = true;
+}
+
+//
+// AddLayer(startNS)
+// Time one layer's Render. Only the render side calls this.
+//
+void SS_Profiler::AddLayer(Uint64 startNS)
+{
+    if (enabled && layerCount < SS_PROFILE_LAYERS)
+        layerTime[layerCount++] = Since(startNS);
+}
+
+//
+// EndFrame(simFrame)
+//
+//  Collect the stage times into the next ring slot and start
+//  a new frame. The slot's sequence is odd while it is being
+//  filled so readers can tell a torn copy from a good one.
+//
+void SS_Profiler::EndFrame(Uint32 simFrame)
+{
+    Uint64  now = Now();
+
+    if (enabled)
+    {
+        Uint32  n = written.load(std::memory_order_relaxed);
+        Slot    &slot = ring[n % SS_PROFILE_FRAMES];
+
+        slot.seq.store(n * 2 + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        SS_ProfileFrame &f = slot.data;
+        f.frame     = n;
+        f.simFrame  = simFrame;
+        f.total     = (Uint32)((now - frameStart) / 1000);
+
+        for (int s=0; s<SS_STAGE_COUNT; s++)
+            f.stage[s] = accum[s].exchange(0, std::memory_order_relaxed);
+
+        f.layerCount = layerCount;
+        for (int i=0; i<layerCount; i++)
+            f.layer[i] = layerTime[i];
+
+        slot.seq.store(n * 2 + 2, std::memory_order_release);
+        written.store(n + 1, std::memory_order_release);
+    }
+
+    layerCount = 0;
+    frameStart = now;
+}
+
+//
+// GetFrame(back, out)
+//
+//  Copy a finished frame, 0 being the latest. Returns false
+//  if the frame isn't available or was overwritten while
+//  being read.
+//
+bool SS_Profiler::GetFrame(Uint32 back, SS_ProfileFrame *out) const
+{
+    Uint32  n = written.load(std::memory_order_acquire);
+
+    if (back >= n || back >= SS_PROFILE_FRAMES)
+        return false;
+
+    Uint32      want = n - 1 - back;
+    const Slot  &slot = ring[want % SS_PROFILE_FRAMES];
+
+    Uint32  seq1 = slot.seq.load(std::memory_order_acquire);
+    *out = slot.data;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    Uint32  seq2 = slot.seq.load(std::memory_order_relaxed);
+
+    return seq1 == seq2 && seq1 == want * 2 + 2;
+}
+
+//
+// GetAverage(frames, out)
+// Average the last few frames. Returns how many were used.
+//
+Uint32 SS_Profiler::GetAverage(Uint32 frames, SS_ProfileFrame *out) const
+{
+    Uint64          total = 0, stage[SS_STAGE_COUNT] = { 0 }, layer[SS_PROFILE_LAYERS] = { 0 };
+    Uint16          layers = 0;
+    Uint32          used = 0;
+    SS_ProfileFrame f;
+
+    memset(out, 0, sizeof(SS_ProfileFrame));
+
+    for (Uint32 b=0; b<frames; b++)
+    {
+        if (!GetFrame(b, &f))
+            continue;
+
+        if (used == 0) {
+            out->frame = f.frame;
+            out->simFrame = f.simFrame;
+        }
+
+        total += f.total;
+        for (int s=0; s<SS_STAGE_COUNT; s++)
+            stage[s] += f.stage[s];
+
+        layers = MAX(layers, f.layerCount);
+        for (int i=0; i<f.layerCount; i++)
+            layer[i] += f.layer[i];
+
+        used++;
+    }
+
+    if (used)
+    {
+        out->total = (Uint32)(total / used);
+        for (int s=0; s<SS_STAGE_COUNT; s++)
+            out->stage[s] = (Uint32)(stage[s] / used);
+
+        out->layerCount = layers;
+        for (int i=0; i<layers; i++)
+            out->layer[i] = (Uint32)(layer[i] / used);
+    }
+
+    return used;
+}
+
+//
+// StageName(stage)
+//
+const char* SS_Profiler::StageName(int s)
+{
+    static const char *names[SS_STAGE_COUNT] = {
+        "input", "events", "collisions", "process",
+        "physics", "animate", "render", "swap"
+    };
+
+    return names[s];
+}
+
+//
+// StageColor(stage, color)
+//
+void SS_Profiler::StageColor(int s, SScolorb *color)
+{
+    static const SScolorb colors[SS_STAGE_COUNT] = {
+        { 0x80, 0x80, 0x80, 0xFF },     // input
+        { 0xC0, 0xC0, 0xC0, 0xFF },     // events
+        { 0xF0, 0xFF, 0x00, 0xFF },     // collisions
+        { 0x00, 0xC0, 0xFF, 0xFF },     // process
+        { 0xC0, 0x60, 0xFF, 0xFF },     // physics
+        { 0x00, 0xFF, 0x80, 0xFF },     // animate
+        { 0xFF, 0x80, 0x00, 0xFF },     // render
+        { 0xFF, 0x20, 0x20, 0xFF }      // swap
+    };
+
+    *color = colors[s];
+}
+
+//
+// Draw(x, y, budgetMS)
+//
+//  Draw a stacked bar for each frame in the ring, newest at
+//  the right, rising from (x, y) in screen pixels. One frame
+//  budget is 100 pixels high and is marked with a white line.
+//  Call it from a PostRender proc, like DrawCollisionGraph.
+//
+void SS_Profiler::Draw(float x, float y, float budgetMS) const
+{
+    const float     scale = 100.0f / (budgetMS * 1000.0f);    // pixels per microsecond
+    SS_ProfileFrame f;
+    SScolorb        c;
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, ss_video_w, ss_video_h, 0, -1.0f, 1.0f);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    gl_do_texture(0);
+    gl_do_blend(1);
+
+    for (Uint32 b=0; b<SS_PROFILE_FRAMES; b++)
+    {
+        if (!GetFrame(b, &f))
+            break;
+
+        float x1 = x + (SS_PROFILE_FRAMES - 1 - b) * 3;
+        float y1 = y;
+
+        for (int s=0; s<SS_STAGE_COUNT; s++)
+        {
+            float h = f.stage[s] * scale;
+            if (h < 0.5f) continue;
+
+            StageColor(s, &c);
+            glColor4ub(c.r, c.g, c.b, 0xC0);
+            glRectf(x1, y1 - h, x1 + 2, y1);
+            y1 -= h;
+        }
+    }
+
+    glColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
+    glRectf(x, y - 101, x + SS_PROFILE_FRAMES * 3, y - 100);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
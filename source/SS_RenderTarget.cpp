@@ -0,0 +1,303 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_RenderTarget.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#define GL_GLEXT_PROTOTYPES 1       // FBO and PBO entry points
+
+#include "SS_RenderTarget.h"
+
+#include "SS_Game.h"
+
+#include <SDL_opengl.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//
+// HasExtension
+// Check the GL extension string for a feature
+//
+static bool HasExtension(const char *name)
+{
+    const char *ext = (const char*)glGetString(GL_EXTENSIONS);
+    return ext != nullptr && strstr(ext, name) != nullptr;
+}
+
+
+//--------------------------------------------------------------
+// SS_RenderTarget
+//--------------------------------------------------------------
+
+SS_RenderTarget::SS_RenderTarget(int w, int h)
+{
+    DEBUGF(1, "[%p] SS_RenderTarget(%d, %d) CONSTRUCTOR\n", this, w, h);
+
+    Init(w, h);
+}
+
+SS_RenderTarget::~SS_RenderTarget()
+{
+    DEBUGF(1, "[%p] ~SS_RenderTarget() DESTRUCTOR\n", this);
+
+    Dispose();
+}
+
+//
+// Init(w, h)
+//
+//  Make a framebuffer object with an RGBA8 color buffer and
+//  a pair of pixel pack buffers. Without FBO support the
+//  target falls back to the window's back buffer, and
+//  without PBOs captures are read straight into memory.
+//
+void SS_RenderTarget::Init(int w, int h)
+{
+    if (!SS_Game::HasGLContext())
+        throw "No OpenGL context for render target.";
+
+    width       = w;
+    height      = h;
+    fbo         = 0;
+    colorBuffer = 0;
+    nextBuffer  = 0;
+    dropped     = 0;
+
+    for (int i=SS_READBACK_BUFFERS; i--;) {
+        pbo[i]              = 0;
+        cpuBuffer[i]        = nullptr;
+        bufferFrame[i]      = 0;
+        bufferPending[i]    = false;
+    }
+
+    if (HasExtension("GL_EXT_framebuffer_object"))
+    {
+        glGenFramebuffersEXT(1, &fbo);
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, fbo);
+
+        glGenRenderbuffersEXT(1, &colorBuffer);
+        glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, colorBuffer);
+        glRenderbufferStorageEXT(GL_RENDERBUFFER_EXT, GL_RGBA8, width, height);
+        glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_RENDERBUFFER_EXT, colorBuffer);
+
+        GLenum status = glCheckFramebufferStatusEXT(GL_FRAMEBUFFER_EXT);
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+        if (status != GL_FRAMEBUFFER_COMPLETE_EXT) {
+            DEBUGF(1, "SS_RenderTarget: FBO incomplete (0x%04X), using the back buffer\n", status);
+            glDeleteRenderbuffersEXT(1, &colorBuffer);
+            glDeleteFramebuffersEXT(1, &fbo);
+            colorBuffer = fbo = 0;
+        }
+    }
+
+    if (HasExtension("GL_ARB_pixel_buffer_object"))
+    {
+        glGenBuffers(SS_READBACK_BUFFERS, pbo);
+        for (int i=SS_READBACK_BUFFERS; i--;) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, PixelBytes(), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+    {
+        for (int i=SS_READBACK_BUFFERS; i--;)
+            cpuBuffer[i] = (Uint8*)malloc(PixelBytes());
+    }
+}
+
+//
+// Dispose
+//
+void SS_RenderTarget::Dispose()
+{
+    if (pbo[0])
+        glDeleteBuffers(SS_READBACK_BUFFERS, pbo);
+
+    for (int i=SS_READBACK_BUFFERS; i--;) {
+        pbo[i] = 0;
+        if (cpuBuffer[i]) {
+            free(cpuBuffer[i]);
+            cpuBuffer[i] = nullptr;
+        }
+    }
+
+    if (colorBuffer) {
+        glDeleteRenderbuffersEXT(1, &colorBuffer);
+        colorBuffer = 0;
+    }
+
+    if (fbo) {
+        glDeleteFramebuffersEXT(1, &fbo);
+        fbo = 0;
+    }
+}
+
+//
+// Bind
+// Direct all drawing into the target
+//
+void SS_RenderTarget::Bind()
+{
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+
+    if (fbo)
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, fbo);
+
+    glViewport(0, 0, width, height);
+}
+
+//
+// Unbind
+// Go back to drawing into the window
+//
+void SS_RenderTarget::Unbind()
+{
+    if (fbo)
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+}
+
+//
+// BindForRead
+// Point glReadPixels at the target's color buffer
+//
+void SS_RenderTarget::BindForRead()
+{
+    if (fbo) {
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, fbo);
+        glReadBuffer(GL_COLOR_ATTACHMENT0_EXT);
+    }
+    else
+        glReadBuffer(GL_BACK);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+}
+
+//
+// CopyFlipped(src, dst)
+// GL rows run bottom-up; hand back top-down rows like SDL
+//
+void SS_RenderTarget::CopyFlipped(const Uint8 *src, Uint8 *dst)
+{
+    Uint32 pitch = width * 4;
+
+    for (int y=0; y<height; y++)
+        memcpy(dst + y * pitch, src + (height - 1 - y) * pitch, pitch);
+}
+
+//
+// ReadPixels(rgba)
+//
+//  Read the target into the given buffer right now, waiting
+//  for the GPU to finish drawing. The buffer must hold
+//  PixelBytes() bytes and gets top-down RGBA rows.
+//
+void SS_RenderTarget::ReadPixels(Uint8 *rgba)
+{
+    Uint8   *raw = (Uint8*)malloc(PixelBytes());
+
+    BindForRead();
+    if (pbo[0]) glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, raw);
+    if (fbo) glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+    CopyFlipped(raw, rgba);
+    free(raw);
+}
+
+//
+// Capture(frame)
+//
+//  Start reading back what was just drawn, tagged with the
+//  given frame number. With PBOs the copy happens on the GPU
+//  side and this returns right away; the pixels are picked
+//  up later with GetPixels, normally one frame behind.
+//  Captures that are never read are dropped oldest-first.
+//
+void SS_RenderTarget::Capture(Uint32 frame)
+{
+    Uint16  b = nextBuffer;
+
+    if (bufferPending[b])
+        dropped++;
+
+    BindForRead();
+
+    if (pbo[b]) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[b]);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, cpuBuffer[b]);
+
+    if (fbo) glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+    bufferFrame[b]      = frame;
+    bufferPending[b]    = true;
+    nextBuffer          = (b + 1) % SS_READBACK_BUFFERS;
+}
+
+//
+// HasPendingCapture
+//
+bool SS_RenderTarget::HasPendingCapture() const
+{
+    for (int i=SS_READBACK_BUFFERS; i--;)
+        if (bufferPending[i])
+            return true;
+
+    return false;
+}
+
+//
+// GetPixels(rgba, frame, wait)
+//
+//  Copy the oldest finished capture into the buffer and
+//  return its frame tag. The most recent capture is still
+//  in flight, so it is only read if wait is true (which may
+//  stall), e.g. to flush the last frame at the end of a run.
+//  Returns false if there was nothing to read.
+//
+bool SS_RenderTarget::GetPixels(Uint8 *rgba, Uint32 *frame, bool wait)
+{
+    for (int i=0; i<SS_READBACK_BUFFERS; i++)
+    {
+        Uint16  b = (nextBuffer + i) % SS_READBACK_BUFFERS;
+
+        if (!bufferPending[b])
+            continue;
+
+        if (i == SS_READBACK_BUFFERS - 1 && !wait)
+            return false;
+
+        if (pbo[b]) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[b]);
+            Uint8 *src = (Uint8*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if (src) {
+                CopyFlipped(src, rgba);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (!src) return false;
+        }
+        else
+            CopyFlipped(cpuBuffer[b], rgba);
+
+        if (frame) *frame = bufferFrame[b];
+        bufferPending[b] = false;
+        return true;
+    }
+
+    return false;
+}
@@ -89,7 +89,8 @@ SS_SFont::SS_SFont(const char *filename, float desc)
 
 SS_SFont::~SS_SFont()
 {
-    if (height != 0.0)
+    // Headless fonts never made any textures
+    if (height != 0.0 && SS_Game::HasGLContext())
         glDeleteTextures(SS_CHR_COUNT, gl_texture);
 }
 
@@ -122,7 +123,7 @@ void SS_SFont::LoadFont(const char *filename, float desc)
     //
     // Purge old textures associated with this SFont
     //
-    if (height != 0.0)
+    if (height != 0.0 && SS_Game::HasGLContext())
         glDeleteTextures(SS_CHR_COUNT, gl_texture);
 
     //
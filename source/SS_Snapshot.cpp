@@ -0,0 +1,159 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Snapshot.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_Snapshot.h"
+
+#include "SS_Frame.h"
+#include "SS_Layer.h"
+#include "SS_World.h"
+
+#include <SDL_thread.h>
+
+
+//--------------------------------------------------------------
+// SS_RenderSnapshot
+//--------------------------------------------------------------
+
+SS_RenderSnapshot::SS_RenderSnapshot()
+{
+    liveCount   = 0;
+    frame       = 0;
+    clearColor.r = clearColor.g = clearColor.b = 0.0f;
+    clearColor.a = 1.0f;
+}
+
+SS_RenderSnapshot::~SS_RenderSnapshot()
+{
+    Clear();
+}
+
+//
+// Clear
+//
+//  Let go of the frames and empty the snapshot. This is only
+//  ever called on the sim thread, so frame ref counts are
+//  never touched by two threads at once.
+//
+void SS_RenderSnapshot::Clear()
+{
+    for (SS_SnapItem &it : items)
+        it.frame->Release();
+
+    items.clear();
+    layers.clear();
+    liveCount = 0;
+}
+
+//
+// BeginLayer(layer)
+// Start a layer, recording its projection as it is now
+//
+void SS_RenderSnapshot::BeginLayer(SS_Layer *layer)
+{
+    SS_SnapLayer    sl;
+
+    sl.layer    = layer;
+    sl.first    = (Uint32)items.size();
+    sl.count    = 0;
+    sl.live     = false;
+    layer->GetProjection(&sl.left, &sl.top, &sl.width, &sl.height);
+
+    layers.push_back(sl);
+}
+
+//
+// AddItem
+//
+void SS_RenderSnapshot::AddItem(SS_Frame *frame, float x, float y, float rot, float xs, float ys, const SScolorb &tint)
+{
+    SS_SnapItem     it;
+
+    frame->Retain();
+
+    it.frame    = frame;
+    it.x        = x;
+    it.y        = y;
+    it.rot      = rot;
+    it.xscale   = xs;
+    it.yscale   = ys;
+    it.tint     = tint;
+
+    items.push_back(it);
+}
+
+//
+// DropLayerItems
+// Throw out whatever the current layer added so far
+//
+void SS_RenderSnapshot::DropLayerItems()
+{
+    Uint32  first = layers.back().first;
+
+    for (Uint32 i = first; i < items.size(); i++)
+        items[i].frame->Release();
+
+    items.resize(first);
+}
+
+//
+// EndLayer(live)
+//
+void SS_RenderSnapshot::EndLayer(bool live)
+{
+    SS_SnapLayer    &sl = layers.back();
+
+    if (live) {
+        DropLayerItems();
+        liveCount++;
+    }
+
+    sl.live     = live;
+    sl.count    = (Uint32)items.size() - sl.first;
+}
+
+//
+// Render(world, liveMutex)
+//
+//  Draw the snapshot. Captured layers need no lock at all.
+//  Live layers are drawn from the world itself, so the
+//  world mutex is held while they render, and a layer that
+//  has been deleted since the snapshot is skipped.
+//
+void SS_RenderSnapshot::Render(SS_World *world, SDL_mutex *liveMutex)
+{
+    for (SS_SnapLayer &sl : layers)
+    {
+        if (sl.live)
+        {
+            if (liveMutex) SDL_LockMutex(liveMutex);
+
+            SS_Layer            *layer;
+            SS_LayerIterator    itr = world->GetIterator();
+            while ((layer = itr.NextItem()))
+                if (layer == sl.layer) {
+                    if (layer->enabled) layer->Render();
+                    break;
+                }
+
+            if (liveMutex) SDL_UnlockMutex(liveMutex);
+            continue;
+        }
+
+        gl_bind_texture(0);
+
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(sl.left, sl.left + sl.width, sl.top + sl.height, sl.top, -1.0f, 1.0f);
+
+        SS_SnapItem *it = items.data() + sl.first;
+        for (Uint32 i = sl.count; i--; it++)
+            it->frame->Render(it->x, it->y, it->rot, it->xscale, it->yscale, it->tint);
+    }
+}
@@ -113,6 +113,9 @@ void SS_Sound::Load(const char *filename)
 {
     DEBUGF(1, "[%p] SS_Sound::Load(%s)\n", this, filename);
 
+    // No audio device (e.g. headless), so stay silent
+    if (!g_mixer) return;
+
     std::string full = SS_Folder::FullPath(filename);
 
     // MIX_LoadAudio replaces Mix_LoadWAV. predecode=true so playback is
@@ -351,6 +354,9 @@ void SS_Music::Init()
 void SS_Music::Load(const char *filename)
 {
     DEBUGF(1, "[%p] SS_Music::Load(%s)\n", this, filename);
+
+    if (!g_mixer) return;
+
     std::string full = SS_Folder::FullPath(filename);
 
     // Same MIX_Audio type as SFX; just a longer sample. (Streaming via
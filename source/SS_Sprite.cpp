@@ -9,6 +9,7 @@
  */
 
 #include "SS_Sprite.h"
+#include "SS_Snapshot.h"
 
 #include "SS_Game.h"
 #include "SS_SFont.h"
@@ -203,51 +204,64 @@ void SS_Sprite::CenterHandle(Uint16 frame)
 }
 
 //
-// Render
+// DrawPosition
+// Work out where the sprite's frame is drawn, and at what scale
 //
-void SS_Sprite::Render(const SScolorb &inTint)
+void SS_Sprite::DrawPosition(float *outX, float *outY, float *outXS, float *outYS)
 {
-    if ( IsVisible() )
-    {
-        float       x = xpos, y = ypos;
-        float       xs = xscale, ys = yscale;
-        SS_World    *w = World();
-        float       z = w->Zoom();
-        Uint32      f = flags;
-
-        //
-        // Reverse scaling on non-zoomed objects in a zoomable layer
-        //
-        if ((f & SS_NOZOOM) && !(layer->flags & SS_NOZOOM)) {
-            xs /= z;
-            ys /= z;
-        }
+    float       x = xpos, y = ypos;
+    float       xs = xscale, ys = yscale;
+    SS_World    *w = World();
+    float       z = w->Zoom();
+    Uint32      f = flags;
+
+    //
+    // Reverse scaling on non-zoomed objects in a zoomable layer
+    //
+    if ((f & SS_NOZOOM) && !(layer->flags & SS_NOZOOM)) {
+        xs /= z;
+        ys /= z;
+    }
 
-        //
-        // Absolute items' coordinates are relative to the view
-        //
-        if (f & SS_NOSCROLL)
-        {
-            x += w->left;
-            y += w->top;
+    //
+    // Absolute items' coordinates are relative to the view
+    //
+    if (f & SS_NOSCROLL)
+    {
+        x += w->left;
+        y += w->top;
 
-            if (!(f & SS_NOZOOM) && !(layer->flags & SS_NOSCROLL)) {
-                x += (w->ZoomWidth() - oldW) / 2;
-                y += (w->ZoomHeight() - oldH) / 2;
-            }
+        if (!(f & SS_NOZOOM) && !(layer->flags & SS_NOSCROLL)) {
+            x += (w->ZoomWidth() - oldW) / 2;
+            y += (w->ZoomHeight() - oldH) / 2;
         }
-        else
+    }
+    else
+    {
+        // A Spatially scaled layer?
+        float   s = layer->spatialScale;
+        if (s != 1.0)
         {
-            // A Spatially scaled layer?
-            float   s = layer->spatialScale;
-            if (s != 1.0)
-            {
-                float wl = w->left, wt = w->top;
+            float wl = w->left, wt = w->top;
 
-                x += wl - (wl / s);
-                y += wt - (wt / s);
-            }
+            x += wl - (wl / s);
+            y += wt - (wt / s);
         }
+    }
+
+    *outX = x; *outY = y;
+    *outXS = xs; *outYS = ys;
+}
+
+//
+// Render
+//
+void SS_Sprite::Render(const SScolorb &inTint)
+{
+    if ( IsVisible() )
+    {
+        float   x, y, xs, ys;
+        DrawPosition(&x, &y, &xs, &ys);
 
         SScolorb outTint;
         MultiplyColorQuads(inTint, tint, outTint);
@@ -255,6 +269,62 @@ void SS_Sprite::Render(const SScolorb &inTint)
     }
 }
 
+//
+// Snapshot
+// Record the sprite's current frame, position and tint
+//
+bool SS_Sprite::Snapshot(SS_RenderSnapshot *snap, const SScolorb &inTint)
+{
+    if ( IsVisible() )
+    {
+        float   x, y, xs, ys;
+        DrawPosition(&x, &y, &xs, &ys);
+
+        SScolorb outTint;
+        MultiplyColorQuads(inTint, tint, outTint);
+        snap->AddItem(frameArray[currFrame], x, y, rotation, xs, ys, outTint);
+    }
+
+    return true;
+}
+
+
+//
+// RotatedBox(angle, le, to, ri, bo, ...)
+// The extents of a box around the origin after rotating it
+//
+static void RotatedBox(Uint16 angle, float le, float to, float ri, float bo, float *left, float *top, float *right, float *bottom)
+{
+    float   rcos = SS_Game::Cos(angle);
+    float   rsin = SS_Game::Sin(angle);
+
+    if (rcos > 0)
+    {
+        if (rsin > 0) { // SE
+            *left = (le * rcos - bo * rsin);    // b-l
+            *right = (ri * rcos - to * rsin);   // t-r
+            *top = (to * rcos + le * rsin);     // t-l
+            *bottom = (bo * rcos + ri * rsin);  // b-r
+        } else {        // NE
+            *left = (le * rcos - to * rsin);    // t-l
+            *right = (ri * rcos - bo * rsin);   // b-r
+            *top = (to * rcos + ri * rsin);     // t-r
+            *bottom = (bo * rcos + le * rsin);  // b-l
+        }
+    } else {
+        if (rsin > 0) { // SW
+            *left = (ri * rcos - bo * rsin);    // b-r
+            *right = (le * rcos - to * rsin);   // t-l
+            *top = (bo * rcos + le * rsin);     // b-l
+            *bottom = (to * rcos + ri * rsin);  // t-r
+        } else {        // NW
+            *left = (ri * rcos - to * rsin);    // t-r
+            *right = (le * rcos - bo * rsin);   // b-l
+            *top = (bo * rcos + ri * rsin);     // b-r
+            *bottom = (to * rcos + le * rsin);  // t-l
+        }
+    }
+}
 
 //
 // IsOnScreen
@@ -266,9 +336,6 @@ bool SS_Sprite::IsOnScreen()
     SS_Point    point;
     GlobalPosition(&point);
 
-    float   rcos = SS_Game::Cos(point.i);
-    float   rsin = SS_Game::Sin(point.i);
-
     // Get the sides of the sprite
     SS_Frame    *fr = frameArray[currFrame];
     float   le = -fr->xhandle * xscale;
@@ -287,33 +354,7 @@ bool SS_Sprite::IsOnScreen()
 
     // Get the extents of the rotated box
     float   left, right, top, bottom;
-
-    if (rcos > 0)
-    {
-        if (rsin > 0) { // SE
-            left = (le * rcos - bo * rsin);     // b-l
-            right = (ri * rcos - to * rsin);    // t-r
-            top = (to * rcos + le * rsin);      // t-l
-            bottom = (bo * rcos + ri * rsin);   // b-r
-        } else {        // NE
-            left = (le * rcos - to * rsin);     // t-l
-            right = (ri * rcos - bo * rsin);    // b-r
-            top = (to * rcos + ri * rsin);      // t-r
-            bottom = (bo * rcos + le * rsin);   // b-l
-        }
-    } else {
-        if (rsin > 0) { // SW
-            left = (ri * rcos - bo * rsin);     // b-r
-            right = (le * rcos - to * rsin);    // t-l
-            top = (bo * rcos + le * rsin);      // b-l
-            bottom = (to * rcos + ri * rsin);   // t-r
-        } else {        // NW
-            left = (ri * rcos - to * rsin);     // t-r
-            right = (le * rcos - bo * rsin);    // b-l
-            top = (bo * rcos + ri * rsin);      // b-r
-            bottom = (to * rcos + le * rsin);   // t-l
-        }
-    }
+    RotatedBox(point.i, le, to, ri, bo, &left, &top, &right, &bottom);
 
     // Get the screen-local coordinates (0,0 is top-left)
     float   x = point.x - w->left;
@@ -333,6 +374,39 @@ bool SS_Sprite::IsOnScreen()
 }
 
 
+//
+// CollisionBounds(&left, &top, &right, &bottom)
+//
+//  The rotated box IsOnScreen uses, in world coordinates.
+//  The mask test doesn't scale, so a shrunken sprite still
+//  gets a box big enough for its frame at full size.
+//
+void SS_Sprite::CollisionBounds(float *left, float *top, float *right, float *bottom)
+{
+    if (frameArray.empty())
+    {
+        SS_Collider::CollisionBounds(left, top, right, bottom);
+        return;
+    }
+
+    SS_Point    point;
+    GlobalPosition(&point);
+
+    SS_Frame    *fr = frameArray[currFrame];
+    float   xs = MAX(fabsf(xscale), 1.0f);
+    float   ys = MAX(fabsf(yscale), 1.0f);
+    float   le = -fr->xhandle * xs;
+    float   to = -fr->yhandle * ys;
+    float   ri = le + fr->width * xs;
+    float   bo = to + fr->height * ys;
+
+    RotatedBox(point.i, le, to, ri, bo, left, top, right, bottom);
+
+    *left += point.x;   *right += point.x;
+    *top += point.y;    *bottom += point.y;
+}
+
+
 #pragma mark -
 //
 // _TestCollision(item)
@@ -493,7 +567,22 @@ bool SS_Sprite::_TestCollision(SS_Collider *otherItem)
         return true;
 
 
-    // 5. Iterate through the small sprite
+    // 5. Compare whole words, with the smaller mask turned
+    //  to the nearest cached angle and its center placed
+    //  where the rotation above put it. When no cached angle
+    //  is within half a pixel, test pixel by pixel instead.
+    const SS_CollisionMask *lwide = largeFrame->WideMask();
+    const SS_CollisionMask *swide = smallFrame->RotatedMask(irot);
+    if (lwide && swide)
+    {
+        float   hw = sw / 2.0f, hh = sh / 2.0f;
+        float   mx = scx + hw * scos - hh * ssin;
+        float   my = scy + hh * scos + hw * ssin;
+        return lwide->Overlaps(swide, (int)floorf(mx - swide->xorigin + 0.5f), (int)floorf(my - swide->yorigin + 0.5f));
+    }
+
+
+    // 6. Iterate through the small sprite
     //  testing for collisions as we go
 
     lmaskw = (lw + 7) / 8;
@@ -91,7 +91,9 @@ SS_TilePalette::~SS_TilePalette()
 {
     tile_w = 0;
     tile_h = 0;
-    glDeleteTextures(1, &gl_texture);
+
+    if (gl_texture)
+        glDeleteTextures(1, &gl_texture);
 }
 
 
@@ -0,0 +1,317 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Timers.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_Timers.h"
+
+#include <string.h>
+
+// A jump longer than the first two levels is placed afresh
+#define WHEEL_JUMP      (1 << (SS_WHEEL_NEAR_BITS + SS_WHEEL_FAR_BITS))
+
+
+//--------------------------------------------------------------
+// SS_TimerWheel
+//--------------------------------------------------------------
+
+SS_TimerWheel::SS_TimerWheel()
+{
+    memset(nearSlots, 0, sizeof(nearSlots));
+    memset(farSlots, 0, sizeof(farSlots));
+    overdue = nullptr;
+    current = 0;
+    count   = 0;
+}
+
+//
+// ~SS_TimerWheel
+// Leave no timer pointing back at a dead wheel
+//
+SS_TimerWheel::~SS_TimerWheel()
+{
+    DropFired();
+
+    SS_Timer *t = TakeAll();
+    while (t)
+    {
+        SS_Timer *next = t->next;
+        t->next = nullptr;
+        t->wheel = nullptr;
+        t = next;
+    }
+}
+
+//
+// Link(slot, timer)
+//
+void SS_TimerWheel::Link(SS_Timer **slot, SS_Timer *t)
+{
+    t->prev = nullptr;
+    t->next = *slot;
+    if (*slot) (*slot)->prev = t;
+    *slot = t;
+    t->slot = slot;
+}
+
+//
+// Detach(timer)
+// Take a timer out of its slot or the fired list
+//
+void SS_TimerWheel::Detach(SS_Timer *t)
+{
+    if (t->slot)
+    {
+        if (t->prev)
+            t->prev->next = t->next;
+        else
+            *t->slot = t->next;
+
+        if (t->next)
+            t->next->prev = t->prev;
+
+        t->prev = t->next = nullptr;
+        t->slot = nullptr;
+    }
+
+    if (t->firing >= 0)
+    {
+        fired[t->firing] = nullptr;
+        t->firing = -1;
+    }
+}
+
+//
+// Place(timer)
+// Put a timer in the slot for its due time
+//
+void SS_TimerWheel::Place(SS_Timer *t)
+{
+    Sint32  delta = (Sint32)(t->due - current);
+    Uint32  due = t->due;
+
+    if (delta < 0)
+        Link(&overdue, t);
+    else if (delta < SS_WHEEL_NEAR)
+        Link(&nearSlots[due & (SS_WHEEL_NEAR - 1)], t);
+    else
+    {
+        int     level = 0;
+        Uint32  shift = SS_WHEEL_NEAR_BITS;
+
+        while (level < SS_WHEEL_LEVELS - 1 && (Uint32)delta >= (1U << (shift + SS_WHEEL_FAR_BITS)))
+        {
+            level++;
+            shift += SS_WHEEL_FAR_BITS;
+        }
+
+        // Beyond the wheel: park in the furthest slot
+        if ((Uint32)delta >= (1U << (shift + SS_WHEEL_FAR_BITS)))
+            due = current + (1U << (shift + SS_WHEEL_FAR_BITS)) - 1;
+
+        Link(&farSlots[level][(due >> shift) & (SS_WHEEL_FAR - 1)], t);
+    }
+}
+
+//
+// Cascade(slot)
+// Spread a higher-level slot out now that its time has come
+//
+void SS_TimerWheel::Cascade(SS_Timer **slot)
+{
+    SS_Timer *t = *slot;
+    *slot = nullptr;
+
+    while (t)
+    {
+        SS_Timer *next = t->next;
+        t->prev = t->next = nullptr;
+        t->slot = nullptr;
+        Place(t);
+        t = next;
+    }
+}
+
+//
+// Fire(slot)
+// Move every timer in a slot to the fired list
+//
+void SS_TimerWheel::Fire(SS_Timer **slot)
+{
+    SS_Timer *t = *slot;
+    *slot = nullptr;
+
+    while (t)
+    {
+        SS_Timer *next = t->next;
+        t->prev = t->next = nullptr;
+        t->slot = nullptr;
+        t->firing = (Sint32)fired.size();
+        fired.push_back(t);
+        t = next;
+    }
+}
+
+//
+// TakeAll
+// Unlink every scheduled timer into one chain
+//
+SS_Timer* SS_TimerWheel::TakeAll()
+{
+    SS_Timer *chain = nullptr;
+
+    auto take = [&](SS_Timer **slot) {
+        SS_Timer *t = *slot;
+        *slot = nullptr;
+        while (t) {
+            SS_Timer *next = t->next;
+            t->prev = nullptr;
+            t->slot = nullptr;
+            t->next = chain;
+            chain = t;
+            t = next;
+        }
+    };
+
+    take(&overdue);
+    for (int i=0; i<SS_WHEEL_NEAR; i++)
+        take(&nearSlots[i]);
+    for (int l=0; l<SS_WHEEL_LEVELS; l++)
+        for (int i=0; i<SS_WHEEL_FAR; i++)
+            take(&farSlots[l][i]);
+
+    return chain;
+}
+
+//
+// DropFired
+// Unschedule fired timers the caller didn't put back
+//
+void SS_TimerWheel::DropFired()
+{
+    for (SS_Timer *t : fired)
+    {
+        if (t) {
+            t->firing = -1;
+            t->wheel = nullptr;
+            count--;
+        }
+    }
+
+    fired.clear();
+}
+
+//
+// Schedule(timer, due)
+// Schedule or reschedule a timer
+//
+void SS_TimerWheel::Schedule(SS_Timer *t, Uint32 due)
+{
+    if (t->wheel != this)
+    {
+        if (t->wheel)
+            t->wheel->Cancel(t);
+
+        t->wheel = this;
+        count++;
+    }
+    else
+        Detach(t);
+
+    t->due = due;
+    Place(t);
+}
+
+//
+// Cancel(timer)
+//
+void SS_TimerWheel::Cancel(SS_Timer *t)
+{
+    if (t->wheel != this)
+        return;
+
+    Detach(t);
+    t->wheel = nullptr;
+    count--;
+}
+
+//
+// Advance(now)
+//
+//  Run the wheel up to and including world time "now" and
+//  return the timers that came due. If the clock jumped a
+//  long way, or went backwards (e.g. a new fixed timestep
+//  restarted it), every timer is placed again instead;
+//  going backwards keeps the time each had left to wait.
+//
+std::vector<SS_Timer*>& SS_TimerWheel::Advance(Uint32 now)
+{
+    DropFired();
+
+    Sint32 gap = (Sint32)(now - current);
+
+    if (count == 0)
+    {
+        current = now + 1;
+        return fired;
+    }
+
+    if (gap < 0 || gap >= WHEEL_JUMP)
+    {
+        SS_Timer *t = TakeAll();
+
+        Uint32 old = current;
+        current = now + 1;
+
+        while (t)
+        {
+            SS_Timer *next = t->next;
+            t->next = nullptr;
+
+            if (gap < 0)
+            {
+                Sint32 left = (Sint32)(t->due - old);
+                t->due = now + (left > 0 ? left : 0);
+            }
+
+            if ((Sint32)(t->due - now) <= 0) {
+                t->firing = (Sint32)fired.size();
+                fired.push_back(t);
+            }
+            else
+                Place(t);
+
+            t = next;
+        }
+
+        return fired;
+    }
+
+    Fire(&overdue);
+
+    while ((Sint32)(now - current) >= 0)
+    {
+        Uint32 index = current & (SS_WHEEL_NEAR - 1);
+
+        if (index == 0)
+        {
+            Uint32 shift = SS_WHEEL_NEAR_BITS;
+            for (int l=0; l<SS_WHEEL_LEVELS; l++, shift += SS_WHEEL_FAR_BITS)
+            {
+                Uint32 slot = (current >> shift) & (SS_WHEEL_FAR - 1);
+                Cascade(&farSlots[l][slot]);
+                if (slot) break;
+            }
+        }
+
+        Fire(&nearSlots[index]);
+        current++;
+    }
+
+    return fired;
+}
@@ -115,6 +115,15 @@ bool MakeTextureFromSurface(
 //  while (expw < sRect.w) { expw <<= 1; }
 //  while (exph < sRect.h) { exph <<= 1; }
 
+    // Headless: report the sizes but there's nowhere to put a texture
+    if (!SS_Game::HasGLContext())
+    {
+        if (outTxWidth)     *outTxWidth = expw;
+        if (outTxHeight)    *outTxHeight = exph;
+        *outTexture = 0;
+        return true;
+    }
+
     // Test whether OpenGL can handle this texture size
     GLint   width;
     glTexImage2D(GL_PROXY_TEXTURE_2D, 0, GL_RGBA8, expw, exph, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
@@ -20,12 +20,12 @@
 // SS_VectorFrame
 //
 
-SS_VectorFrame::SS_VectorFrame(GLfloat *vex, Uint16 len)
+SS_VectorFrame::SS_VectorFrame(GLfloat *vex, Uint32 len)
 {
     Init();
 
     Begin(SS_OUTLINE_POLYGON);
-    for (int i=0; i<len*2; i+=2)
+    for (Uint32 i=0; i<len*2; i+=2)
         AppendVector(vex[i], vex[i+1]);
     End();
 }
@@ -147,7 +147,7 @@ void SS_VectorFrame::AppendVector(float x, float y)
 //
 // PrependVectorList
 //
-void SS_VectorFrame::PrependVectorList(SSVectorType mode, ssVector *list, Uint16 size)
+void SS_VectorFrame::PrependVectorList(SSVectorType mode, ssVector *list, Uint32 size)
 {
     Begin(mode, true);
     Unit()->vectorList.Prepend(list, size);
@@ -157,7 +157,7 @@ void SS_VectorFrame::PrependVectorList(SSVectorType mode, ssVector *list, Uint16
 //
 // AppendVectorList
 //
-void SS_VectorFrame::AppendVectorList(SSVectorType mode, ssVector *list, Uint16 size)
+void SS_VectorFrame::AppendVectorList(SSVectorType mode, ssVector *list, Uint32 size)
 {
     Begin(mode);
     Unit()->vectorList.Append(list, size);
@@ -389,7 +389,7 @@ void SS_VectorFrame::AppendStar(float x, float y, float r1, float r2, int p, boo
 //
 // PopFirst
 //
-void SS_VectorFrame::PopFirst(Uint16 count)
+void SS_VectorFrame::PopFirst(Uint32 count)
 {
     if (unitList.Size())
     {
@@ -401,7 +401,7 @@ void SS_VectorFrame::PopFirst(Uint16 count)
 //
 // PopLast
 //
-void SS_VectorFrame::PopLast(Uint16 count)
+void SS_VectorFrame::PopLast(Uint32 count)
 {
     if (unitList.Size())
     {
@@ -476,6 +476,9 @@ void SS_VectorFrame::Render()
 //
 void SS_VectorFrame::InitDisplayList()
 {
+    if (!SS_Game::HasGLContext())
+        return;
+
     if (gl_list == 0)
         gl_list = glGenLists(1);
 
@@ -0,0 +1,153 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Workers.cpp
+ *
+ *  $Id$
+ *
+ */
+
+#include "SS_Workers.h"
+
+// Set on pool threads and while the caller is inside a job
+static thread_local bool inWorkerJob = false;
+
+
+//--------------------------------------------------------------
+// SS_WorkerPool
+//--------------------------------------------------------------
+
+//
+// SS_WorkerPool(count)
+// Start the given number of threads, or one per spare core
+//
+SS_WorkerPool::SS_WorkerPool(int count)
+{
+    DEBUGF(1, "[%p] SS_WorkerPool(%d) CONSTRUCTOR\n", this, count);
+
+    jobProc     = nullptr;
+    jobData     = nullptr;
+    jobCount    = 0;
+    jobGrain    = 1;
+    jobNext     = 0;
+    jobSerial   = 0;
+    busy        = 0;
+    quit        = false;
+
+    if (count <= 0)
+        count = SDL_GetNumLogicalCPUCores() - 1;
+
+    for (int i=0; i<count; i++)
+        threads.emplace_back(&SS_WorkerPool::WorkerLoop, this);
+}
+
+SS_WorkerPool::~SS_WorkerPool()
+{
+    DEBUGF(1, "[%p] ~SS_WorkerPool() DESTRUCTOR\n", this);
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &t : threads)
+        t.join();
+}
+
+//
+// Shared
+// The pool everything in the engine uses
+//
+SS_WorkerPool* SS_WorkerPool::Shared()
+{
+    static SS_WorkerPool pool(SS_WORKER_THREADS);
+    return &pool;
+}
+
+//
+// RunChunks
+// Take chunks of the current job until it runs dry
+//
+void SS_WorkerPool::RunChunks()
+{
+    Uint32  start;
+
+    while ((start = jobNext.fetch_add(jobGrain)) < jobCount)
+    {
+        Uint32 end = MIN(start + jobGrain, jobCount);
+        for (Uint32 i = start; i < end; i++)
+            jobProc(jobData, i);
+    }
+}
+
+//
+// WorkerLoop
+//
+void SS_WorkerPool::WorkerLoop()
+{
+    Uint32  seen = 0;
+
+    inWorkerJob = true;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&]{ return quit || jobSerial != seen; });
+            if (quit) return;
+            seen = jobSerial;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (--busy == 0)
+                finished.notify_one();
+        }
+    }
+}
+
+//
+// Run(count, proc, data, grain)
+//
+//  Call proc(data, i) for every i below count, spread across
+//  the pool, and wait for all of them. Indices are handed out
+//  grain at a time; use a bigger grain for tiny jobs.
+//
+void SS_WorkerPool::Run(Uint32 count, workerProc proc, void *data, Uint32 grain)
+{
+    if (count == 0)
+        return;
+
+    // No helpers, nothing worth splitting, or already in a job
+    if (threads.empty() || count <= grain || inWorkerJob)
+    {
+        for (Uint32 i = 0; i < count; i++)
+            proc(data, i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> running(runLock);
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobProc     = proc;
+        jobData     = data;
+        jobCount    = count;
+        jobGrain    = grain ? grain : 1;
+        jobNext     = 0;
+        busy        = (int)threads.size();
+        jobSerial++;
+    }
+    wake.notify_all();
+
+    inWorkerJob = true;
+    RunChunks();
+    inWorkerJob = false;
+
+    std::unique_lock<std::mutex> guard(lock);
+    finished.wait(guard, [&]{ return busy == 0; });
+}
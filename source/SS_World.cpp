@@ -15,10 +15,18 @@
 #include "SS_Sprite.h"
 #include "SS_Layer.h"
 #include "SS_GUI.h"
+#include "SS_RenderTarget.h"
+#include "SS_Snapshot.h"
+#include "SS_Workers.h"
+
+#include <stdlib.h>
 
 // Useful OpenGL Globals
 glState     gl_state;
 
+// Marks a published snapshot the renderer hasn't picked up
+#define SS_SNAP_FRESH   0x100
+
 //
 extern bool ss_vsync;
 
@@ -46,6 +54,9 @@ SS_World::~SS_World()
 
     Stop();
     DisposeAll();
+
+    for (int i=3; i--;)
+        delete snapshots[i];
 }
 
 //
@@ -64,11 +75,11 @@ void SS_World::Init()
     processThread   = nullptr;
     renderThread    = nullptr;
 
-    calibrating     = false;
-    caliCount       = 0;
     frameCount      = 0;
-    slowCount       = 0;
+    swapTime        = 0;
     fps             = 0;
+    stepCount       = 0;
+    sps             = 0;
     timeAdjust      = 0;
     stopTime        = 0;
 
@@ -90,9 +101,31 @@ void SS_World::Init()
     lastAutoTime    = 0;
     fireAuto        = false;
 
+    lastPhysTick    = 0;
+
+    simStep         = 0;
+    simMaxSteps     = 5;
+    simTime         = 0;
+    simAccumulator  = 0;
+    simLastTick     = 0;
+    simFrame        = 1;
+    simAlpha        = 0.0f;
+    interpolate     = true;
+
     pointerSprite   = nullptr;
     latchedLayer    = nullptr;
 
+    renderTarget    = nullptr;
+    captureFrames   = false;
+
+    pipelined       = false;
+    deferNodes      = false;
+    for (int i=3; i--;)
+        snapshots[i] = nullptr;
+    simSnap         = 0;
+    renderSnap      = 1;
+    readySnap       = 2;
+
     SetSurface(SS_Game::TheScreen());
     SetLeftTop(0, 0);
     SetZoom(1);
@@ -143,70 +176,101 @@ Uint32 SS_World::Run(SS_Game *g)
     DEBUGF(1, "[%p] SS_World::Run(%p)\n", this, g);
 
     Uint32  interval, old, tick;
+    Uint64  frameStart;
 
     game = g;
     if (g->IsQuitting())
         return 0;
 
-    if (ss_vsync)
+    if (ss_vsync && !SS_Game::IsHeadless())
         Calibrate();
+    else
+        pacer.Start(SS_PACE_FREE, 0);
+
+    frameStats.Reset();
 
     Start();
 
+    old = SDL_GetTicks();
+    frameStart = SS_Profiler::Now();
+
     while ( !worldQuit && !game->IsQuitting())              // while the world has not been quit
     {
-#if !SS_THREADS
-        ticks = GetWorldTime();
-#endif
+        Uint32 renderTime = 0;
 
+        pacer.Wait();                       // throttle before reading input
+
+        Uint64 t = SS_Profiler::Now();
         GetInput();                         // get a snapshot of all input states
+        profiler.AddStage(SS_STAGE_INPUT, t);
+
+        t = SS_Profiler::Now();
         HandleEvents();                     // handle events
+        profiler.AddStage(SS_STAGE_EVENTS, t);
 
 #if !SS_THREADS
-
         if (processFlag)
-        {
-            static Uint32 collTick = 0;
-            if (GetWorldTime() - collTick > 5)
-            {
-                collTick = GetWorldTime();
-                RunCollisionTest();
-            }
-
-            Process();
-#if SS_PHYSICS_ENABLE
-            {
-                static Uint32 lastPhysTick = 0;
-                Uint32 now = GetWorldTime();
-                if (lastPhysTick == 0) lastPhysTick = now;
-                float dt = (now - lastPhysTick) / 1000.0f;
-                lastPhysTick = now;
-                AnimatePhysics(dt);
-            }
-#endif
-            Animate();
-        }
+            Simulate();                     // catch the simulation up to now
+        else if (!simStep)
+            ticks = GetWorldTime();
 #endif
 
         if (renderFlag)                         // if rendering is enabled
         {
+            t = SS_Profiler::Now();
             Render();                           // do so
+            renderTime = SS_Profiler::Since(t);
 
-            frameCount++;                       // calculate FPS every 2 seconds
-            tick = GetWorldTime();
-            interval = tick - old;
-            if (interval >= 2000)
-            {
-                fps = (int)(1000.0 * frameCount / interval + 0.5);
-                old = tick;
-                frameCount = 0;
-            }
+            frameCount++;
         }
+
+        tick = SDL_GetTicks();                  // calculate FPS and SPS every 2 seconds,
+        interval = tick - old;                  // rendering or not
+        if (interval >= 2000)
+        {
+            fps = (int)(1000.0 * frameCount / interval + 0.5);
+            sps = (int)(1000.0 * stepCount / interval + 0.5);
+            old = tick;
+            frameCount = 0;
+            stepCount = 0;
+        }
+
+        pacer.EndFrame(renderFlag ? swapTime : 0);
+        profiler.EndFrame(simFrame);
+
+        SS_ProfileFrame prof;
+        bool            haveProf = profiler.IsEnabled() && profiler.GetFrame(0, &prof);
+
+        t = SS_Profiler::Now();
+        frameStats.AddFrame((Uint32)((t - frameStart) / 1000), renderTime, simFrame, haveProf ? &prof : nullptr);
+        frameStart = t;
     }
 
     Stop();
 
-    return fps;
+    WriteFrameStats();
+
+    // Nothing was drawn, so report the simulation rate
+    return SS_Game::IsHeadless() ? sps : fps;
+}
+
+//
+// WriteFrameStats
+//
+//  Save the frame statistics of the last Run to the file set
+//  by SetFrameStatsFile, or named by the SS_FRAMESTATS
+//  environment variable. A ".json" name gets JSON, anything
+//  else CSV.
+//
+void SS_World::WriteFrameStats()
+{
+    const char *path = statsFile.c_str();
+
+    if (!*path)
+        path = getenv("SS_FRAMESTATS");
+
+    if (path && *path && !frameStats.Write(path))
+        DEBUGF(1, "[%p] SS_World::WriteFrameStats - Can't write \"%s\"\n", this, path);
 }
 
 //
@@ -279,11 +343,167 @@ void SS_World::SetPaused(bool p)
         stopTime = SDL_GetTicks();
     else if (stopTime != 0)
         timeAdjust += (SDL_GetTicks() - stopTime);
+
+    // The sim clock simply stops while paused
+    simLastTick = 0;
+}
+
+//
+// SetFixedTimestep(ms, maxSteps)
+//
+//  Run the simulation in fixed steps of the given length.
+//  Real elapsed time is fed into an accumulator and whole
+//  steps are taken from it, so every run of the same input
+//  yields the same sequence of world states regardless of
+//  the frame rate. No more than maxSteps are run per frame;
+//  any backlog beyond that is dropped so a slow machine
+//  runs in slow motion rather than spiraling.
+//
+//  The sim clock starts from zero so repeated runs line up.
+//  A step of 0 restores the original variable-rate clock.
+//
+void SS_World::SetFixedTimestep(Uint32 ms, Uint16 maxSteps)
+{
+    DEBUGF(1, "[%p] SS_World::SetFixedTimestep(%d, %d)\n", this, ms, maxSteps);
+
+    if (ms && !simStep)
+        simTime = 0;
+    else if (!ms && simStep)
+        timeAdjust = (Uint32)SDL_GetTicks() - simTime;  // continue from the sim time
+
+    simStep         = ms;
+    simMaxSteps     = maxSteps ? maxSteps : 1;
+    simAccumulator  = 0;
+    simLastTick     = 0;
+    simAlpha        = 0.0f;
+
+    ticks           = GetWorldTime();
+    lastAutoTime    = ticks;
+    lastPhysTick    = ticks;
+}
+
+//
+// SetRenderTarget(target, capture)
+//
+//  Render the world into an offscreen target instead of the
+//  window. With capture on, every rendered frame is queued
+//  for async readback, tagged with its sim frame, and can be
+//  collected with target->GetPixels. The world doesn't own
+//  the target; pass nullptr to go back to the window.
+//
+void SS_World::SetRenderTarget(SS_RenderTarget *target, bool capture)
+{
+    DEBUGF(1, "[%p] SS_World::SetRenderTarget(%p, %d)\n", this, target, capture);
+
+    renderTarget    = target;
+    captureFrames   = capture;
+}
+
+//
+// DrawProfileGraph(x, y)
+//
+//  Draw the profiler overlay with its base at (x, y), or near
+//  the bottom of the screen if y is negative. The budget line
+//  is one fixed step, or a 60Hz frame on a variable clock.
+//
+void SS_World::DrawProfileGraph(float x, float y)
+{
+    if (y < 0)
+        y = ss_video_h - 8;
+
+    profiler.Draw(x, y, simStep ? (float)simStep : 1000.0f / 60);
+}
+
+//
+// SetPipelined(p)
+//
+//  Render from snapshots instead of from the layers. After
+//  each Simulate the sim side records what every layer would
+//  draw and publishes it; Render draws the newest published
+//  snapshot. With SS_THREADS the two sides then never wait on
+//  each other, except for layers that must be drawn live
+//  (tiles, text, GUI, groups) which still take the lock.
+//
+//  Snapshots hold the state after the last step, so items
+//  are not interpolated in this mode.
+//
+void SS_World::SetPipelined(bool p)
+{
+    DEBUGF(1, "[%p] SS_World::SetPipelined(%d)\n", this, p);
+
+    #if SS_THREADS
+    if (worldMutex) SDL_LockMutex(worldMutex);
+    #endif
+
+    if (p && snapshots[0] == nullptr)
+        for (int i=3; i--;)
+            snapshots[i] = new SS_RenderSnapshot();
+
+    pipelined = p;
+
+    #if SS_THREADS
+    if (worldMutex) SDL_UnlockMutex(worldMutex);
+    #endif
+}
+
+//
+// PublishSnapshot
+//
+//  Fill the sim side's snapshot and swap it into the ready
+//  slot. The renderer's buffer is never touched here, so the
+//  swap is a single atomic exchange.
+//
+void SS_World::PublishSnapshot()
+{
+    #if SS_THREADS
+    SDL_LockMutex(worldMutex);
+    #endif
+
+    SS_RenderSnapshot   *snap = snapshots[simSnap];
+
+    snap->Clear();
+    snap->frame         = simFrame;
+    snap->clearColor    = clearColor;
+
+    SS_Layer            *layer;
+    SS_LayerIterator    itr = GetIterator();
+    while ((layer = itr.NextItem()))
+        if (layer->enabled)
+            layer->Snapshot(snap);
+
+    #if SS_THREADS
+    SDL_UnlockMutex(worldMutex);
+    #endif
+
+    simSnap = readySnap.exchange(simSnap | SS_SNAP_FRESH) & ~SS_SNAP_FRESH;
+}
+
+//
+// DrawSnapshot
+// Pick up the newest snapshot, if there is one, and draw it
+//
+void SS_World::DrawSnapshot()
+{
+    if (readySnap.load() & SS_SNAP_FRESH)
+        renderSnap = readySnap.exchange(renderSnap) & ~SS_SNAP_FRESH;
+
+    SS_RenderSnapshot   *snap = snapshots[renderSnap];
+
+    SScolorf &cc = snap->clearColor;
+    glClearColor(cc.r, cc.g, cc.b, cc.a);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    PreRender();
+    snap->Render(this, worldMutex);
+    PostRender();
 }
 
 //
 // Calibrate
-// Start testing the frame rate to see if VBL Sync is okay
+//
+//  Start pacing with VBL Sync at the display's refresh rate.
+//  The pacer keeps watching frame times from then on, and
+//  leaves vsync only while the frames don't fit in it.
 //
 void SS_World::Calibrate()
 {
@@ -291,11 +511,7 @@ void SS_World::Calibrate()
 
     frameCount = 0;
 
-    SS_Game::SyncVblank(1);
-
-    calibrating = true;
-    caliCount = 120;
-    slowCount = 0;
+    pacer.Start(SS_PACE_VSYNC, SS_Game::RefreshRate());
 }
 
 //
@@ -332,13 +548,157 @@ void SS_World::GetInput()
 
     keyState = SS_GetKeyState(nullptr);
 
-    mouseButtons = SDL_GetMouseState(&fx, &fy);
+    if (!SS_Game::IsHeadless())
+        mouseButtons = SDL_GetMouseState(&fx, &fy);
+}
+
+//
+// Simulate
+//
+//  Bring the simulation up to date. With a variable clock
+//  this is a single pass at the current world time. With a
+//  fixed timestep it runs as many whole steps as the real
+//  time since the last call allows, advancing ticks by
+//  exactly one step each time.
+//
+//  A headless game has no display to keep pace with, so a
+//  fixed-step world free-runs one step per call instead.
+//
+void SS_World::Simulate()
+{
+    if (!simStep)
+    {
+        ticks = GetWorldTime();
+
+        Uint64 stepStart = SS_Profiler::Now();
+
+        Uint64 t = SS_Profiler::Now();
+        RunCollisionTest();
+        profiler.AddStage(SS_STAGE_COLLISIONS, t);
+
+        if (lastPhysTick == 0) lastPhysTick = ticks;
+        float dt = (ticks - lastPhysTick) / 1000.0f;
+        lastPhysTick = ticks;
+
+        Step(dt);
+
+        frameStats.AddStep(SS_Profiler::Since(stepStart));
+
+        if (pipelined)
+            PublishSnapshot();
+
+        return;
+    }
+
+    if (SS_Game::IsHeadless())
+        simAccumulator += simStep;
+    else
+    {
+        Uint32 now = SDL_GetTicks();
+        if (simLastTick == 0) simLastTick = now;
+        simAccumulator += now - simLastTick;
+        simLastTick = now;
+    }
+
+    bool    ranSteps = false;
+
+    for (Uint16 steps = 0; simAccumulator >= simStep; steps++)
+    {
+        if (steps == simMaxSteps)
+        {
+            simAccumulator %= simStep;          // too far behind - drop the backlog
+            break;
+        }
+
+        ticks = simTime;
+        Uint64 t = SS_Profiler::Now();
+        RunCollisionTest();
+        profiler.AddStage(SS_STAGE_COLLISIONS, t);
+        Step(simStep / 1000.0f);
+        frameStats.AddStep(SS_Profiler::Since(t));
+
+        simTime += simStep;
+        simAccumulator -= simStep;
+        simFrame++;
+        ranSteps = true;
+    }
+
+    ticks = simTime;
+    simAlpha = (float)simAccumulator / simStep;
+
+    if (pipelined && ranSteps)
+        PublishSnapshot();
+}
+
+//
+// Step(dt)
+// Process, step physics, and Animate once
+//
+void SS_World::Step(float dt)
+{
+#if SS_THREADS
+    SDL_LockMutex(worldMutex);      // increment the mutex, and if >1 then wait
+#endif
+
+    Uint64 t = SS_Profiler::Now();
+    Process();
+    profiler.AddStage(SS_STAGE_PROCESS, t);
+#if SS_PHYSICS_ENABLE
+    t = SS_Profiler::Now();
+    AnimatePhysics(dt);
+    profiler.AddStage(SS_STAGE_PHYSICS, t);
+#endif
+    t = SS_Profiler::Now();
+    Animate();
+    profiler.AddStage(SS_STAGE_ANIMATE, t);
+
+    stepCount++;
+
+#if SS_THREADS
+    SDL_UnlockMutex(worldMutex);    // decrement the mutex
+#endif
+}
+
+//
+// GatherIndependentLayers
+//
+//  List the active layers flagged SS_INDEPENDENT, in world
+//  order. Returns true if there are enough of them, and
+//  enough worker threads, to be worth running in parallel.
+//
+bool SS_World::GatherIndependentLayers()
+{
+    parallelLayers.clear();
+
+    if (SS_WorkerPool::Shared()->ThreadCount() == 0)
+        return false;
+
+    SS_Layer            *layer;
+    SS_LayerIterator    itr = GetIterator();
+
+    while ((layer = itr.NextItem()))
+        if (layer->enabled && !layer->paused && layer->IsIndependent())
+            parallelLayers.push_back(layer);
+
+    return parallelLayers.size() >= 2;
 }
 
+//
+// Worker pool entry points for parallel layers
+//
+void SS_World::process_layer(void *w, Uint32 i) { ((SS_World*)w)->parallelLayers[i]->Process(); }
+void SS_World::animate_layer(void *w, Uint32 i) { ((SS_World*)w)->parallelLayers[i]->Animate(); }
+void SS_World::run_timer(void *l, Uint32 i)     { SS_Timer *t = (*(std::vector<SS_Timer*>*)l)[i]; ((SS_LayerItem*)t->owner)->RunTimer(t); }
+
 //
 // Process
 // Tell all the layers in the world to Process
 //
+//  Independent layers are processed together on the worker
+//  pool first. Then, in world order, each of them is joined
+//  (removals and collision node updates) and the remaining
+//  layers are processed as usual.
+//
 
 void SS_World::Process()
 {
@@ -348,9 +708,25 @@ void SS_World::Process()
     SS_Layer            *layer;
     SS_LayerIterator    itr = GetIterator();
 
+    bool    parallel = GatherIndependentLayers();
+    Uint32  next = 0;
+
+    if (parallel)
+    {
+        deferNodes = true;
+        SS_WorkerPool::Shared()->Run((Uint32)parallelLayers.size(), process_layer, this);
+        deferNodes = false;
+    }
+
     while ((layer = itr.NextItem()))
-        if (layer->enabled && !layer->paused)
+    {
+        if (parallel && next < parallelLayers.size() && layer == parallelLayers[next]) {
+            layer->FinishParallel();
+            next++;
+        }
+        else if (layer->enabled && !layer->paused)
             layer->Process();
+    }
 
     // Delete marked layers
     itr.Start();
@@ -358,9 +734,76 @@ void SS_World::Process()
         if (layer->removeFlag)
             delete layer;
 
+    RunTimers();
+
     PostProcess();
 }
 
+//
+// RunTimers
+//
+//  Call Process and Animate for the items whose timers have
+//  come due, in the order they fell due, and put each timer
+//  back for its next turn. Only due items are touched. Items
+//  in a disabled or paused layer wait another interval.
+//
+//  SS_PURE items are left in the due list for a second pass
+//  on the worker pool, moves first and then animations, with
+//  collision nodes settled in order at each join. Anything
+//  a serial proc cancels in the meantime drops out of the
+//  list, so it's never run.
+//
+void SS_World::RunTimers()
+{
+    std::vector<SS_Timer*>  &due = timers.Advance(ticks);
+    bool                    parallel = SS_WorkerPool::Shared()->ThreadCount() > 0;
+
+    for (size_t i = 0; i < due.size(); i++)
+    {
+        SS_Timer *t = due[i];
+        if (!t) continue;                   // cancelled since it fell due
+
+        SS_LayerItem *item = (SS_LayerItem*)t->owner;
+
+        if (item->removeFlag)
+            timers.Cancel(t);
+        else if (!item->layer->enabled || item->layer->paused)
+            timers.Schedule(t, ticks + (t->kind == SS_TIMER_MOVE ? item->moveInterval : item->animInterval));
+        else if (!(parallel && item->Flags(SS_PURE)))
+        {
+            item->RunTimer(t);
+            if (t->kind == SS_TIMER_MOVE)
+                item->FinishParallel();     // settle collision nodes, as _Process does
+            item->ScheduleTimer(t);         // (clears its entry)
+        }
+    }
+
+    // Whatever is left is pure
+    pureTimers[SS_TIMER_MOVE].clear();
+    pureTimers[SS_TIMER_ANIMATE].clear();
+
+    for (SS_Timer *t : due)
+        if (t) pureTimers[t->kind].push_back(t);
+
+    for (int k = SS_TIMER_MOVE; k <= SS_TIMER_ANIMATE; k++)
+    {
+        std::vector<SS_Timer*> &list = pureTimers[k];
+        if (list.empty()) continue;
+
+        deferNodes = true;
+        SS_WorkerPool::Shared()->Run((Uint32)list.size(), run_timer, &list, SS_PARALLEL_GRAIN);
+        deferNodes = false;
+
+        for (SS_Timer *t : list)
+        {
+            SS_LayerItem *item = (SS_LayerItem*)t->owner;
+            if (k == SS_TIMER_MOVE)
+                item->FinishParallel();
+            item->ScheduleTimer(t);
+        }
+    }
+}
+
 //
 // PostProcess
 // Process something after all the layers
@@ -380,9 +823,19 @@ void SS_World::Animate()
     SS_Layer            *layer;
     SS_LayerIterator    itr = GetIterator();
 
+    bool    parallel = GatherIndependentLayers();
+    Uint32  next = 0;
+
+    if (parallel)
+        SS_WorkerPool::Shared()->Run((Uint32)parallelLayers.size(), animate_layer, this);
+
     while ((layer = itr.NextItem()))
-        if (layer->enabled && !layer->paused)
+    {
+        if (parallel && next < parallelLayers.size() && layer == parallelLayers[next])
+            next++;
+        else if (layer->enabled && !layer->paused)
             layer->Animate();
+    }
 }
 
 //
@@ -391,25 +844,55 @@ void SS_World::Animate()
 //
 void SS_World::Render()
 {
-    Uint64       tick = SDL_GetTicks();
+    // Headless: there's nothing to draw into
+    if (!SS_Game::HasGLContext())
+        return;
+
+    Uint64      t = SS_Profiler::Now();
+
+    // Snapshots don't need the world locked
+    bool        pipe = pipelined;
 
     #if SS_THREADS
-    SDL_LockMutex(worldMutex);  // No processing in this portion
+    if (!pipe) SDL_LockMutex(worldMutex);  // No processing in this portion
     #endif
 
-    glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
-    glClear(GL_COLOR_BUFFER_BIT);       // Clear the display buffer
+    if (renderTarget)
+        renderTarget->Bind();           // Draw offscreen
 
-    PreRender();
+    if (pipe)
+        DrawSnapshot();
+    else
+    {
+        glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+        glClear(GL_COLOR_BUFFER_BIT);       // Clear the display buffer
 
-    SS_Layer            *layer;
-    SS_LayerIterator    itr = GetIterator();
+        PreRender();
 
-    while ((layer = itr.NextItem()))
-        if (layer->enabled)
-            layer->Render();
+        SS_Layer            *layer;
+        SS_LayerIterator    itr = GetIterator();
 
-    PostRender();
+        while ((layer = itr.NextItem()))
+            if (layer->enabled)
+            {
+                Uint64 lt = SS_Profiler::Now();
+                layer->Render();
+                profiler.AddLayer(lt);
+            }
+
+        PostRender();
+    }
+
+    if (renderTarget)
+    {
+        if (captureFrames)                      // Async readback, picked up next frame
+            renderTarget->Capture(pipe ? snapshots[renderSnap]->frame : simFrame);
+
+        renderTarget->Unbind();
+    }
+
+    profiler.AddStage(SS_STAGE_RENDER, t);
+    t = SS_Profiler::Now();
 
     //
     // Swap buffers and allow processing to continue.
@@ -422,33 +905,21 @@ void SS_World::Render()
     // unlock the processor. On modern machines this works fine.
     //
     #ifdef WIN32
-    SDL_GL_SwapWindow(SS_Game::TheWindow());
+    if (!SS_Game::IsHeadless())
+        SDL_GL_SwapWindow(SS_Game::TheWindow());
     #endif
 
     #if SS_THREADS
-    SDL_UnlockMutex(worldMutex);
+    if (!pipe) SDL_UnlockMutex(worldMutex);
     #endif
 
     #ifndef WIN32
-    SDL_GL_SwapWindow(SS_Game::TheWindow());
+    if (!SS_Game::IsHeadless())
+        SDL_GL_SwapWindow(SS_Game::TheWindow());
     #endif
 
-    //
-    // Calibration test
-    //
-    if (calibrating)
-    {
-        if (SDL_GetTicks() - tick > (1000 / 50))
-            slowCount++;
-
-        if (!--caliCount)
-        {
-            calibrating = false;
-
-            if (slowCount >= 60)
-                SS_Game::SyncVblank(0);
-        }
-    }
+    swapTime = SS_Profiler::Since(t);
+    profiler.AddStage(SS_STAGE_SWAP, t);
 }
 
 //
@@ -685,33 +1156,13 @@ int SS_World::ProcessThread()
 {
     while (!processQuit)
     {
-        ticks = GetWorldTime();
-
         if (processFlag)
         {
-            static Uint32 collTick = 0;
-            if (GetWorldTime() - collTick > 5)
-            {
-                collTick = GetWorldTime();
-                RunCollisionTest();
-            }
-
-            SDL_LockMutex(worldMutex);      // increment the mutex, and if >1 then wait
-            Process();
-#if SS_PHYSICS_ENABLE
-            {
-                static Uint32 lastPhysTick = 0;
-                Uint32 now = GetWorldTime();
-                if (lastPhysTick == 0) lastPhysTick = now;
-                float dt = (now - lastPhysTick) / 1000.0f;
-                lastPhysTick = now;
-                AnimatePhysics(dt);
-            }
-#endif
-            Animate();
-            SDL_UnlockMutex(worldMutex);    // decrement the mutex
-            SDL_Delay(5);
+            Simulate();
+            SDL_Delay(simStep ? 1 : 5);
         }
+        else if (!simStep)
+            ticks = GetWorldTime();
     }
 
     return 0;
@@ -13,15 +13,46 @@
 
 #include "SS_LayerItem.h"
 
+#include <unordered_map>
+#include <vector>
+
 #define SS_COLLISION_TYPES 64
 
+//
+// Colliders are kept apart by the lowest bit they generate,
+// with one more class for items that only receive
+//
+#define SS_COLLISION_CLASSES    33
+#define SS_COLLISION_RECEIVER   32
+
+//
+// Stages of a contact between two colliders
+//
+enum contactPhase {
+    SS_CONTACT_BEGIN,               // first frame touching
+    SS_CONTACT_STAY,                // still touching
+    SS_CONTACT_END                  // no longer touching
+};
+
+//
+// How colliders are sorted into lists
+//
+enum collisionBroadphase {
+    SS_BROADPHASE_BANDS,            // vertical bands by x position
+    SS_BROADPHASE_GRID,             // a hash of square cells
+    SS_BROADPHASE_SWEEP             // boxes kept sorted on x
+};
+
 #pragma mark -
 class SS_Collider;
+class SS_CollisionManager;
 typedef TObjectList<SS_Collider*>   SS_ColliderObjectList;
 typedef TLinkedList<SS_Collider*>   SS_ColliderList;
 typedef TListNode<SS_Collider*>     SS_ColliderNode;
 typedef TIterator<SS_Collider*>     SS_ColliderIterator;
 
+typedef bool (*colliderProc)(SS_Collider *item, void *data);
+
 
 #pragma mark -
 class SS_Collider : public SS_LayerItem
@@ -30,6 +61,8 @@ class SS_Collider : public SS_LayerItem
 
     protected:
         SS_ColliderNode         *collNode;                  // node in the collision list
+        SS_CollisionManager     *collManager;               // manager holding the node
+        Uint8                   collClass;                  // collision class it's listed under
 
         // Collisions
         bool                    isCollider;                 // has been added to the collider list
@@ -39,13 +72,23 @@ class SS_Collider : public SS_LayerItem
         bool                    collisionUpdated;           // flag that collisions have been updated
         Uint32                  collisionIgnore;            // collisions to ignore
         Uint16                  collisionSource;            // an id number not to collide with
+        bool                    continuous;                 // also test the path it moved along
 
     public:
         int                     listNumber;                 // which collision list am i in?
+        Sint32                  cellX, cellY;               // band or grid cell it was placed by
+        bool                    oversize;                   // bigger than a band, so never cut by distance
+        float                   boxLeft, boxTop;            // bounds as of the last sweep
+        float                   boxRight, boxBottom;
+        Sint32                  sweepIndex;                 // place in the sweep order, or -1
+        Uint32                  colliderID;                 // key for contact pairs, 0 = none
+        Uint16                  contactCount;               // contact pairs it's in
+        float                   sweepX, sweepY;             // where its last swept test left it
 
     public:
                                 SS_Collider() { Init(); }
                                 SS_Collider(const SS_Collider &src) { Init(); *this = src; }
+        virtual                 ~SS_Collider()              { RemoveFromColliders(); }
 
         void                    SetWorld(SS_World *w) override;
 
@@ -66,6 +109,7 @@ class SS_Collider : public SS_LayerItem
         inline void             CollisionAdd(Uint32 m)          { collisions |= m; }
         inline void             CollisionAdd(SS_Collider *s)    { CollisionAdd(s->CollisionOut()); }
         virtual void            CollideWith(SS_Collider *s);
+        virtual void            HandleCollision(SS_Collider *other, contactPhase phase);
         inline bool             CanCollide(SS_Collider *s) {
             return (    IsVisible() && s->IsVisible()
                     &&  ((collisionOut & s->collisionIn) != 0)
@@ -74,8 +118,12 @@ class SS_Collider : public SS_LayerItem
                     );
                 }
         inline void             SetCollisionOrigin(Uint16 n)    { collisionSource = n; }
+        void                    SetContinuous(bool on);
+        inline bool             IsContinuous() const            { return continuous; }
+        void                    ResetSweep();
 
         virtual void            _Process() override;
+        void                    FinishParallel() override       { UpdateNodePosition(); }
 
         void                    EnableCollisions(Uint32 out, Uint32 in);
         void                    AddToColliders();
@@ -85,6 +133,7 @@ class SS_Collider : public SS_LayerItem
         Uint32                  GetNewCollisions();
         bool                    TestCollision(SS_Collider *other);
         virtual bool            _TestCollision(SS_Collider *other) { return false; }
+        virtual void            CollisionBounds(float *left, float *top, float *right, float *bottom);
 
 //      virtual bool            TestPointCollision(float x, float y, bool isLocal=false);
 
@@ -93,29 +142,178 @@ class SS_Collider : public SS_LayerItem
 };
 
 
+#pragma mark -
+//
+// Where a collider was when its contact was last tested
+//
+struct SS_ContactPose
+{
+    float               x, y;
+    Uint16              angle, frame;
+
+    inline bool         operator==(const SS_ContactPose &p) const { return x == p.x && y == p.y && angle == p.angle && frame == p.frame; }
+};
+
+//
+// A pair of colliders found touching
+//
+struct SS_Contact
+{
+    SS_Collider         *a, *b;
+    SS_ContactPose      poseA, poseB;
+    Uint32              generation;             // last test that found them touching
+    float               time;                   // part of the last move before they met
+    bool                begun;                  // begin has been reported
+};
+
+typedef std::unordered_map<Uint64, SS_Contact>  SS_ContactMap;
+
+struct SS_ContactEvent
+{
+    SS_Collider         *a, *b;
+    contactPhase        phase;
+};
+
+//
+// A pair tested on a worker thread, applied later in order
+//
+struct SS_PairResult
+{
+    SS_Collider         *a, *b;
+    SS_ContactPose      poseA, poseB;
+    float               time;                   // part of the move before they met
+    bool                narrow;                 // the narrow phase was run
+    bool                hit;                    // the narrow phase found them touching
+};
+
+typedef std::vector<SS_PairResult>  SS_PairList;
+
+//
+// Counts from the last collision test
+//
+struct SS_CollisionStats
+{
+    Uint32              candidates;             // pairs the broadphase offered that could collide
+    Uint32              narrow;                 // pairs given the narrow phase
+    Uint32              hits;                   // pairs found touching
+};
+
+
 #pragma mark -
 class SS_CollisionManager
 {
     friend class SS_Collider;
 
     private:
-        SS_ColliderList         colliderList[SS_COLLISION_LISTS];
-//      SS_ColliderList         colliderList[SS_COLLISION_TYPES][SS_COLLISION_LISTS];
+        SS_ColliderList         colliderList[SS_COLLISION_CLASSES][SS_COLLISION_LISTS];
+        SS_ColliderList         *cellList;                  // grid buckets, made on demand
+        SS_ColliderList         sweepList;                  // all colliders, when sweeping
+        SS_ColliderList         largeList;                  // colliders too big for a band or cell
+        std::vector<SS_Collider*>   sweepOrder;             // sorted by boxLeft, with gaps
+        collisionBroadphase     broadphase;
+        float                   cellSize;
+
+        // Generate / receive table
+        Uint32                  classCount[SS_COLLISION_CLASSES];
+        Uint32                  bitCount[SS_COLLISION_CLASSES][2][32];  // members using each out / in bit
+        Uint32                  classOut[SS_COLLISION_CLASSES];         // union of members' out bits
+        Uint32                  classIn[SS_COLLISION_CLASSES];          // union of members' in bits
+        Uint64                  classPairs[SS_COLLISION_CLASSES];       // classes that can collide with each
+        bool                    pairsChanged;
+
+        // Contacts
+        SS_ContactMap           contacts;
+        std::vector<SS_ContactEvent>    contactEvents;      // reused by DispatchContacts
+        Uint32                  contactGeneration;          // collision tests run
+        Uint32                  nextColliderID;
+        SS_CollisionStats       collisionStats;
+
+        // Scheduling
+        Uint32                  collisionBudget;            // us per test, 0 = no limit
+        Uint32                  collisionLag;               // tests the last full pass took
+        Uint32                  pendingUnits;               // units left in this pass
+        unsigned                scheduleCursor;             // next unit in turn
+        Uint32                  cycleStart;                 // test the pass started on
+        std::vector<Uint32>     unitTested;                 // test each unit was last run
+        std::vector<Uint32>     hotMark;                    // epoch a fast mover was seen
+        std::vector<unsigned>   hotUnits;                   // units to test first
+        Uint32                  hotEpoch;
+        std::vector<unsigned>   batchUnits;                 // units tested together by the pool
+        std::vector<SS_PairList>    batchPairs;             // each batch unit's pairs, in order
+
+        // Swept tests
+        std::vector<SS_Collider*>   continuousItems;        // colliders that want them
+        SS_PairList             visitPairs;                 // pairs gathered by a box visit
 
     public:
         SS_CollisionManager();
-        ~SS_CollisionManager()  {}
+        ~SS_CollisionManager();
+
+        void                SetBroadphase(collisionBroadphase b, float size=SS_COLLISION_CELL_SIZE);
+        inline collisionBroadphase Broadphase() const   { return broadphase; }
+        inline float        CellSize() const            { return cellSize; }
 
         SS_ColliderNode*    AddToColliders(SS_Collider *item);
         void                RemoveFromColliders(SS_Collider *item) { item->RemoveFromColliders(); }
+        void                RemoveCollider(SS_Collider *item);
+        void                PlaceCollider(SS_Collider *item);
+        static Uint8        CollisionClass(Uint32 out);
+        bool                ClassesPair(Uint8 a, Uint8 b);
         void                RunCollisionTest();
-        SS_ColliderList*    CollidersAtPoint(float x, float y);
-        SS_Collider*        FirstColliderAt(float x, float y);
-        SS_Collider*        FirstColliderOnLine(float x1, float y1, float x2, float y2);
+        inline size_t       ContactCount() const        { return contacts.size(); }
+        bool                ContactTime(SS_Collider *a, SS_Collider *b, float *time) const;
+        inline const SS_CollisionStats& CollisionStats() const { return collisionStats; }
+        inline void         SetCollisionBudget(Uint32 us) { collisionBudget = us; }
+        inline Uint32       CollisionBudget() const     { return collisionBudget; }
+        inline Uint32       CollisionLag() const        { return collisionLag; }
+        inline Uint32       PendingUnits() const        { return pendingUnits; }
+        SS_ColliderList*    CollidersAtPoint(float x, float y, Uint32 mask=0);
+        int                 CollidersAtPoint(float x, float y, SS_Collider **buffer, int max, Uint32 mask=0);
+        SS_Collider*        FirstColliderAt(float x, float y, Uint32 mask=0);
+        SS_Collider*        FirstColliderOnLine(float x1, float y1, float x2, float y2, float *distance=nullptr, Uint32 mask=0);
+        bool                VisitAround(Sint32 cx, Sint32 cy, colliderProc proc, void *data);
+        bool                VisitNear(float x, float y, colliderProc proc, void *data);
+        bool                VisitBox(float left, float top, float right, float bottom, colliderProc proc, void *data);
         void                DrawCollisionGraph();
 
     private:
         void                Init();
+        int                 ListIndexFor(float x, float y, Uint8 cls, Sint32 *cx, Sint32 *cy);
+        int                 ListCount() const;
+        SS_ColliderList*    ListAt(int i);
+        int                 LargeIndex() const;
+        inline bool         IsLarge(SS_Collider *item) const { return item->listNumber == LargeIndex(); }
+        int                 ListIndexOf(SS_Collider *item);
+        static inline int   CellIndex(Sint32 cx, Sint32 cy, Uint8 cls) {
+            return (int)(((Uint32)cx * 73856093U ^ (Uint32)cy * 19349663U ^ (Uint32)cls * 83492791U) & (SS_COLLISION_CELLS - 1));
+        }
+        void                CountMasks(SS_Collider *item, int delta);
+        void                UpdatePairs();
+        void                TestList(SS_Collider *item, SS_ColliderIterator iter, Sint32 cx, Sint32 cy, Uint8 cls, SS_PairList *out);
+        unsigned            UnitCount() const;
+        unsigned            UnitOf(SS_Collider *item) const;
+        bool                UnitIsEmpty(unsigned u) const;
+        void                MarkFastMover(SS_Collider *item);
+        void                RunScheduled();
+        void                TestBatch();
+        static void         TestBatchUnit(void *data, Uint32 index);
+        void                TestUnit(unsigned u, SS_PairList *out);
+        void                TestBand(unsigned i, SS_PairList *out);
+        void                TestBucket(unsigned i, SS_PairList *out);
+        void                MarkBucket(unsigned u);
+        void                TestPair(SS_Collider *a, SS_Collider *b, SS_PairList *out=nullptr);
+        bool                ProbePair(SS_Collider *a, SS_Collider *b, SS_PairResult *r) const;
+        void                ApplyPair(const SS_PairResult &r);
+        void                TestLarge();
+        static bool         LargeVisit(SS_Collider *item, void *data);
+        void                AddContinuous(SS_Collider *item);
+        void                RemoveContinuous(SS_Collider *item);
+        void                RunContinuousTest();
+        void                DispatchContacts();
+        void                DropContacts(SS_Collider *item);
+        void                SweepInsert(SS_Collider *item);
+        void                SweepSort();
+        void                RunSweepTest();
 };
 
 #endif
@@ -23,6 +23,51 @@
                         //
 #define SS_THREADS          0
 
+                        //
+                        // Worker threads for parallel layers and
+                        // items (0 = one per core, less the caller)
+                        //
+#ifndef SS_WORKER_THREADS
+#define SS_WORKER_THREADS   0
+#endif
+
+                        //
+                        // SS_PURE items per worker chunk. A layer
+                        // with fewer than two chunks runs serially.
+                        //
+#define SS_PARALLEL_GRAIN   256
+
+                        //
+                        // Frame profiler history, and the most
+                        // layers timed individually per frame
+                        //
+#define SS_PROFILE_FRAMES   256
+#define SS_PROFILE_LAYERS   16
+
+                        //
+                        // Frame-time histograms use bins this many
+                        // microseconds wide; longer times share the
+                        // last bin (the max is still exact)
+                        //
+#define SS_HISTOGRAM_US     100
+#define SS_HISTOGRAM_BINS   1000
+
+                        //
+                        // Frames longer than this (microseconds) are
+                        // hitches: a 60Hz frame plus some slack.
+                        // Only the first SS_HITCH_LOG are kept.
+                        //
+#define SS_FRAME_BUDGET     20000
+#define SS_HITCH_LOG        256
+
+                        //
+                        // Frames the pacer stays in a mode before
+                        // it may change again, and how many of its
+                        // mode changes are kept for inspection
+                        //
+#define SS_PACE_DWELL       120
+#define SS_PACE_LOG         64
+
                         //
                         // Using audio I hope?
                         //
@@ -43,6 +88,17 @@
 #define SS_PHYSICS_ENABLE   0
 #endif
 
+                        //
+                        // List nodes come from per-thread pools, a slab
+                        // of this many at a time, so busy lists don't
+                        // call malloc and free. Set to 0 to use new and
+                        // delete for every node.
+                        //
+#ifndef SS_NODE_POOL
+#define SS_NODE_POOL        1
+#endif
+#define SS_NODE_SLAB        512
+
                         //
                         // Maximum number of concurrent worlds
                         //
@@ -54,6 +110,35 @@
 #define SS_COLLISION_LISTS      100
 #define SS_COLLISION_BAND_SIZE  200
 
+                        //
+                        // Spatial hash grid broadphase: buckets (a power
+                        // of two) and the default cell size. Cells should
+                        // be no smaller than SS_COLLISION_BAND_SIZE, the
+                        // furthest apart two colliders are ever tested.
+                        //
+#define SS_COLLISION_CELLS      4096
+#define SS_COLLISION_CELL_SIZE  200
+
+                        //
+                        // Collision scheduling: microseconds each test may
+                        // take (0 for no limit), and the speed per move at
+                        // which an item's band or cell is tested first
+                        //
+#define SS_COLLISION_BUDGET     4000
+#define SS_COLLISION_FAST       8
+
+                        //
+                        // Pre-rotated collision masks per frame, built as
+                        // needed. Rotated pairs compare masks at the nearest
+                        // of these angles, turned about the frame's center.
+                        // That's an approximation, so it's only used when
+                        // the nearest angle moves the mask's corners less
+                        // than half a pixel; otherwise, and when this is 0,
+                        // rotated pairs are tested pixel by pixel. More
+                        // angles let bigger frames use the masks.
+                        //
+#define SS_MASK_ROTATIONS       64
+
                         //
                         // Debug output macro (also used by SS_Templates.h)
                         //
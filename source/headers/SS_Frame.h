@@ -12,6 +12,47 @@
 #include "SS_Types.h"
 #include "SS_RefCounter.h"
 
+#include <atomic>
+
+//--------------------------------------------------------------
+// SS_CollisionMask
+//
+//  A one-bit mask packed into 64-bit words, leftmost pixel
+//  in the low bit, for comparing a word at a time. Rotated
+//  masks are bigger than the frame, and are turned about the
+//  frame's center, so each records where the center landed.
+//
+//  Finish records the box the set pixels occupy and, for
+//  big masks, a coarser level with a bit per 8x8 block:
+//  one set where any pixel in the block is, one where all
+//  of them are. Those levels have levels of their own when
+//  they're still big.
+//
+#define SS_MASK_BLOCK       8
+
+struct SS_CollisionMask
+{
+    Uint16          width, height;      // in pixels
+    Uint16          words;              // words per row
+    float           xorigin, yorigin;   // the frame's center in the mask
+    Uint16          left, top;          // the occupied box
+    Uint16          right, bottom;      // (exclusive; empty if left == right)
+    Uint64          *bits;
+
+    SS_CollisionMask    *anyBlocks;     // blocks with any pixel set
+    SS_CollisionMask    *grownBlocks;   // the same, grown a block right and down
+    SS_CollisionMask    *allBlocks;     // blocks with every pixel set
+
+    static SS_CollisionMask*    New(Uint16 w, Uint16 h);
+    static void                 Dispose(SS_CollisionMask *m);
+
+    inline void     Set(int x, int y)       { bits[y * words + (x >> 6)] |= (Uint64)1 << (x & 63); }
+    inline bool     Get(int x, int y) const { return (bits[y * words + (x >> 6)] >> (x & 63)) & 1; }
+    inline bool     IsEmpty() const         { return left >= right; }
+    void            Finish();
+    bool            Overlaps(const SS_CollisionMask *other, int dx, int dy) const;
+};
+
 //--------------------------------------------------------------
 // SS_Frame
 //
@@ -31,6 +72,10 @@ class SS_Frame : public SS_RefCounter
     protected:
         Uint8           *mask;              // collision mask, if created
         Uint16          maskBytesWide;      // useful value
+        SS_CollisionMask    *wideMask;      // the same in 64-bit rows
+#if SS_MASK_ROTATIONS
+        std::atomic<SS_CollisionMask*>  *rotMasks;  // pre-rotated, built as needed
+#endif
 
     public:
         GLuint          gl_texture;         // OpenGL texture
@@ -52,6 +97,8 @@ class SS_Frame : public SS_RefCounter
         inline void     MakeCollisionMask() { MakeCollisionMask(0x00); }
         void            MakeCollisionMask(Uint8 t);
         void            DisposeMask();
+        inline const SS_CollisionMask* WideMask() const { return wideMask; }
+        const SS_CollisionMask* RotatedMask(Uint16 angle);
         void            DisposeSurface();
         void            DisposeTexture();
         void            DisposeDisplayList();
@@ -70,6 +117,7 @@ class SS_Frame : public SS_RefCounter
 
     private:
         void            Init(frameFlags f);
+        SS_CollisionMask*   BuildRotatedMask(Uint16 angle);
         inline void     Init() { Init((frameFlags)0); }
 };
 
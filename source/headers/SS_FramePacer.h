@@ -0,0 +1,91 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_FramePacer.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_FRAMEPACER_H__
+#define __SS_FRAMEPACER_H__
+
+#include "SS_Types.h"
+
+#include <vector>
+
+//
+// How frames are paced
+//
+enum paceMode {
+    SS_PACE_FREE,               // no vsync, no limit
+    SS_PACE_VSYNC,              // wait for vblank
+    SS_PACE_ADAPTIVE,           // vblank, but swap late frames at once
+    SS_PACE_THROTTLE            // no vsync, sleep to the target time
+};
+
+//--------------------------------------------------------------
+// SS_PaceChange
+// A logged change of pacing mode
+//
+struct SS_PaceChange
+{
+    Uint32              frame;              // pacer frame number
+    paceMode            from, to;
+    Uint32              work;               // smoothed work time (us)
+    Uint32              target;             // target frame time (us)
+};
+
+//--------------------------------------------------------------
+// SS_FramePacer
+//
+//  Keeps a running average of how long each frame's work
+//  takes, not counting the swap or any sleep. When the work
+//  no longer fits in a frame, vsync would halve the frame
+//  rate, so the pacer drops to adaptive vsync (or to sleeping
+//  without vsync) until the work fits comfortably again.
+//  Modes only change after a frame spends a minimum time in
+//  the current one, so a single slow patch can't flip-flop.
+//
+//  Throttled frames sleep at the start of the frame, before
+//  input is read, to keep latency down.
+//
+class SS_FramePacer
+{
+    private:
+        paceMode                    mode;
+        paceMode                    preferred;      // mode used when work fits
+        bool                        adaptive;       // may change modes?
+        bool                        adaptiveOK;     // driver takes swap interval -1
+        Uint64                      target;         // ns per frame, 0 = none
+        Uint64                      frameStart;     // ns
+        Uint64                      deadline;       // ns, throttled frame start
+        float                       work;           // smoothed work time (us)
+        Uint32                      frame;
+        Uint32                      lastChange;     // frame of the last change
+        std::vector<SS_PaceChange>  changes;
+
+    public:
+                                    SS_FramePacer();
+
+        void                        Start(paceMode m, float hz);
+
+        inline paceMode             Mode() const            { return mode; }
+        inline void                 SetAdaptive(bool a)     { adaptive = a; }
+        inline Uint32               TargetTime() const      { return (Uint32)(target / 1000); }
+        inline Uint32               WorkTime() const        { return (Uint32)work; }
+        inline const std::vector<SS_PaceChange>& Changes() const { return changes; }
+        static const char*          ModeName(paceMode m);
+
+        void                        SetTargetRate(float hz);
+        void                        SetMode(paceMode m);
+
+        void                        Wait();
+        void                        EndFrame(Uint32 swapUS);
+
+    private:
+        void                        ChangeMode(paceMode m);
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_FrameStats.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_FRAMESTATS_H__
+#define __SS_FRAMESTATS_H__
+
+#include "SS_Profiler.h"
+
+#include <stdio.h>
+
+#include <vector>
+
+//--------------------------------------------------------------
+// SS_FrameHistogram
+// Counts of times in fixed-width bins, for percentiles
+//
+class SS_FrameHistogram
+{
+    private:
+        Uint32              bins[SS_HISTOGRAM_BINS];
+        Uint32              count;
+        Uint64              sum;                // microseconds
+        Uint32              max;
+
+    public:
+                            SS_FrameHistogram()         { Reset(); }
+
+        void                Reset();
+        void                Add(Uint32 us);
+
+        inline Uint32       Count() const               { return count; }
+        inline Uint32       Max() const                 { return max; }
+        inline Uint32       Mean() const                { return count ? (Uint32)(sum / count) : 0; }
+        Uint32              Percentile(float p) const;
+};
+
+//--------------------------------------------------------------
+// SS_Hitch
+// A frame that ran over budget
+//
+struct SS_Hitch
+{
+    Uint32              frame;              // frame number since Reset
+    Uint32              simFrame;           // world sim frame
+    Uint32              time;               // ms since Reset
+    Uint32              frameTime;          // whole frame (us)
+    Uint32              renderTime;         // Render and swap (us)
+    bool                hasProfile;         // profile is valid
+    SS_ProfileFrame     profile;            // stage breakdown, if profiling
+};
+
+//--------------------------------------------------------------
+// SS_FrameStats
+//
+//  Frame, sim step and render time histograms for one run of
+//  a world, plus a log of the frames that went over budget.
+//  Frames and renders are added by the thread running the
+//  world and steps by the thread simulating it, so each
+//  histogram has a single writer. Read the results once
+//  the world has stopped.
+//
+class SS_FrameStats
+{
+    private:
+        SS_FrameHistogram       frames, steps, renders;
+        std::vector<SS_Hitch>   hitches;
+        Uint32                  hitchCount;     // including those not logged
+        Uint32                  budget;         // hitch threshold (us)
+        Uint64                  startNS;
+
+    public:
+                                SS_FrameStats();
+
+        void                    Reset();
+        inline void             SetBudget(Uint32 us)            { budget = us; }
+        inline Uint32           Budget() const                  { return budget; }
+
+        void                    AddFrame(Uint32 frameUS, Uint32 renderUS, Uint32 simFrame, const SS_ProfileFrame *prof);
+        inline void             AddStep(Uint32 us)              { steps.Add(us); }
+
+        inline const SS_FrameHistogram& Frames() const          { return frames; }
+        inline const SS_FrameHistogram& Steps() const           { return steps; }
+        inline const SS_FrameHistogram& Renders() const         { return renders; }
+        inline Uint32           HitchCount() const              { return hitchCount; }
+        inline const std::vector<SS_Hitch>& Hitches() const     { return hitches; }
+
+        bool                    Write(const char *path) const;
+        void                    WriteCSV(FILE *file) const;
+        void                    WriteJSON(FILE *file) const;
+};
+
+#endif
@@ -77,8 +77,10 @@ class SS_GUI : public SS_Layer
         void                ExitAllRollovers();
 
         virtual void        Process()  override{}
+        bool                RunsItemTimers() const override { return false; }   // gadgets run themselves
         void                Animate() override;
         void                Render() override;
+        bool                Snapshot(SS_RenderSnapshot *snap) override { return SnapshotLive(snap); }
 
     private:
         void                Init();
@@ -16,6 +16,8 @@
 // Global video dimensions (defined in SS_Game.cpp). Declared up-front so the
 // inline accessors below can reference them regardless of include order.
 extern int ss_video_w, ss_video_h;
+extern bool ss_headless;
+extern int ss_offscreen;
 
 #include <SDL.h>
 #include "SS_Types.h"
@@ -104,11 +106,18 @@ class SS_Game
         static inline double        Sin(Uint16 i)   { return SS_sin[i]; }
 
         void                        InitScreen();
+        void                        InitHeadless();
+        void                        InitOffscreen();
+        static void                 InitGLState();
         static inline SDL_Surface*  TheScreen() { return ss_screen; }
         static inline SDL_Window*   TheWindow() { return ss_window; }
         static inline int           ScreenWidth() { return ss_video_w; }
         static inline int           ScreenHeight() { return ss_video_h; }
-        static void                 SyncVblank(long sync);
+        static inline bool          IsHeadless() { return ss_headless; }
+        static inline bool          IsOffscreen() { return ss_headless && ss_offscreen; }
+        static inline bool          HasGLContext() { return ss_glcontext != nullptr; }
+        static bool                 SyncVblank(long sync);
+        static float                RefreshRate();
 
         void                        PushWorld(SS_World *w);
         void                        PopWorld();
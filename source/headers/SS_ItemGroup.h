@@ -23,7 +23,7 @@ class SS_ItemGroup : public SS_Collider, public SS_ColliderObjectList
     public:
                 SS_ItemGroup();
                 SS_ItemGroup(const SS_ItemGroup &src) { *this = src; }
-        virtual ~SS_ItemGroup() {}
+        virtual ~SS_ItemGroup();
 
         virtual const SS_ItemGroup&     operator=(const SS_ItemGroup &src);
         virtual SS_ItemGroup*           Clone()  override{ return new SS_ItemGroup(*this); }
@@ -40,10 +40,13 @@ class SS_ItemGroup : public SS_Collider, public SS_ColliderObjectList
         virtual bool    IsOnScreen();
 
         void            Process() override;
+        void            FinishParallel() override;
         void            Animate() override;
         void            AutoMove() override;
         void            PushAndPrepareMatrix() override;
         void            Render(const SScolorb &inTint) override;
+        void            BeginInterpolation(float alpha) override;
+        void            EndInterpolation() override;
 
         void            EnableCollisions(Uint32 out, Uint32 in);
         void            UpdateCollisions();
@@ -53,6 +56,7 @@ class SS_ItemGroup : public SS_Collider, public SS_ColliderObjectList
 
     private:
         void            Init();
+        void            DisposeMember(SS_ColliderIterator &itr);
 };
 
 
@@ -18,8 +18,13 @@ class SS_ItemList : public TObjectList<SS_LayerItem*>
 {
     public:
         virtual         ~SS_ItemList() { ReleaseAll(); }
+
+        SS_ItemNode*    Enlist(SS_LayerItem *item, bool front=false);
+        bool            Delist(SS_LayerItem *item);
+
         virtual void    RemoveItem(SS_LayerItem *item);
         void            ReleaseAll();
+        void            Clear();
 };
 
 #endif
@@ -20,6 +20,8 @@
 #include "SS_LayerItem.h"
 #include "SS_World.h"
 
+#include <vector>
+
 enum layerType {
     SS_LAYER_PLAIN,
     SS_LAYER_SPRITE,
@@ -37,6 +39,7 @@ class SS_Layer : public SS_Broadcaster, public SS_Listener, public SS_ItemList
     protected:
         SS_World                *world;                         // the world this layer is in
         SScolorb                tint;
+        std::vector<SS_LayerItem*> pureItems;                   // SS_PURE items for the parallel pass
 
     public:
         SS_ItemList             visibleList;                    // everything that ought to be rendered
@@ -61,6 +64,8 @@ class SS_Layer : public SS_Broadcaster, public SS_Listener, public SS_ItemList
         inline Uint32           Flags() const           { return flags; }
         inline Uint32           Flags(Uint32 m) const   { return flags & m; }
         inline bool             IsEnabled() const       { return enabled; }
+        inline bool             IsIndependent() const   { return (flags & SS_INDEPENDENT) != 0; }
+        virtual inline bool     RunsItemTimers() const  { return true; }
         inline SS_LayerItem*    MousePointer() const    { return world ? world->MousePointer() : nullptr; }
         inline GLubyte          Alpha() const           { return tint.a; }
         inline SScolorb         Tint() const            { return tint; }
@@ -75,6 +80,7 @@ class SS_Layer : public SS_Broadcaster, public SS_Listener, public SS_ItemList
         virtual inline void     SetAlpha(GLubyte a)         { tint.a = a; }
         virtual inline void     SetEnabled(bool e)          { enabled = e; }
         virtual inline void     SetPaused(bool p)           { paused = p; }
+        inline void             SetIndependent(bool i)      { if (i) flags |= SS_INDEPENDENT; else flags &= ~SS_INDEPENDENT; }
 
         inline void             Enable()                { SetEnabled(true); }
         inline void             Disable()               { SetEnabled(false); }
@@ -87,24 +93,33 @@ class SS_Layer : public SS_Broadcaster, public SS_Listener, public SS_ItemList
         void                    AddItem(SS_LayerItem *item);
         void                    PrependItem(SS_LayerItem *item);
 
-        inline void             AddToVisible(SS_LayerItem *item) { visibleList.Append(item); }
+        inline void             AddToVisible(SS_LayerItem *item) { visibleList.Enlist(item); }
 
         virtual void            RemoveItem(SS_LayerItem *item) override;
         void                    DisposeItem(SS_LayerItem *item);
 
         virtual void            Process();
+        virtual void            FinishParallel();
         virtual void            Animate();
         virtual void            Render();
+        virtual bool            Snapshot(SS_RenderSnapshot *snap);
 
         virtual bool            HandleEvent(SDL_Event *e)       { return false; }
         virtual bool            HandleEvent(SS_Event *e)        { return false; }
         virtual void            HandleCommand(long command)     {}
 
+        void                    GetProjection(float *x, float *y, float *w, float *h) const;
         void                    PrepareMatrix();            // set the openGL context for this layer
         inline void             RemoveSelf();
 
+    protected:
+        bool                    SnapshotLive(SS_RenderSnapshot *snap);
+
     private:
         void                    Init(Uint32 f=SS_NONE);
+        void                    ProcessPureItems();
+
+        static void             process_pure(void *l, Uint32 i);
 };
 
 #endif
@@ -16,6 +16,7 @@
 
 #include "SS_Types.h"
 #include "SS_RefCounter.h"
+#include "SS_Timers.h"
 #include "SS_Messages.h"
 #include "SS_Utilities.h"
 
@@ -44,6 +45,7 @@ enum itemType {
 
 // Helpful Typedefs
 class SS_LayerItem;
+class SS_Collider;
 typedef TListNode<SS_LayerItem*>    SS_ItemNode;
 typedef TIterator<SS_LayerItem*>    SS_ItemIterator;
 
@@ -61,6 +63,7 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
 {
     friend class SS_Sprite;
     friend class SS_ItemGroup;
+    friend class SS_ItemList;
     friend class SS_Layer;
     friend class SS_World;
 
@@ -70,6 +73,7 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
         SS_ItemGroup            *group;                     // the group
 
         SS_ItemNodeArray        nodeArray;                  // all nodes referencing this item
+        TListNode<SS_Collider*> *groupNode;                 // node in the group's list
 
         // Flags
         Uint32                  flags;                      // the sprite's flags, as above
@@ -82,6 +86,8 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
         // Movement
         Uint32                  lastMoveTime;               // last time the moveProc was called
         spriteProcPtr           moveProc;                   // the sprite's move proc
+        SS_Timer                moveTimer;                  // when Process is next due
+        Uint16                  startPhase;                 // first-run jitter, as a fraction of the interval
 
         // Animation
         Uint32                  lastAnimTime;               // last time the animProc was called
@@ -92,10 +98,17 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
         Uint16                  animLast;                   // last frame in auto-animation
         Sint16                  animIncrement;              // amount to add to currFrame
         Uint32                  animInterval;               // how often to call the animProc
+        SS_Timer                animTimer;                  // when Animate is next due
 
         // Zoom compensation
         float                   oldW, oldH;                 // the world's view size at creation time
 
+        // Fixed-step interpolation
+        float                   lastx, lasty, lastrot;      // state before the last sim step
+        float                   heldx, heldy, heldrot;      // actual state during an interpolated render
+        Uint16                  heldindex;                  // actual rotindex during an interpolated render
+        Uint32                  lastStep;                   // the sim frame lastx/lasty/lastrot lead into
+
     public:
         Uint32                  moveInterval;               // how often to call the moveProc
 
@@ -150,6 +163,7 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
 
         inline void             Kill() { removeFlag = true; }
         virtual void            RemoveSelf();
+        void                    MoveToLayer(SS_Layer *l);
 
         void                    AddPeer(SS_LayerItem *item) const;
         void                    PrependPeer(SS_LayerItem *item) const;
@@ -162,6 +176,7 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
         inline Uint32           Flags(Uint32 m) const   { return flags & m; }
         virtual bool            IsVisible() const;
         inline Uint16           FrameCount() const      { return frameCount; }
+        inline Uint16           FrameIndex() const      { return currFrame; }
 
         // Setters
         virtual void            SetWorld(SS_World *w);
@@ -186,13 +201,19 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
 
         virtual inline void     SetFrameIndex(Uint16 f) { currFrame = f % frameCount; }
         virtual inline void     SetAnimRange(Uint16 start, Uint16 end) { if (end < start) end = start; animFirst = start; animLast = end; }
-        inline void             SetAnimInterval(Uint32 ms) { animInterval = 0; lastAnimTime = 0; animInterval = ms; }
+        void                    SetAnimInterval(Uint32 ms);
         inline void             SetAnimIncrement(Sint16 inc) { animIncrement = inc; }
         void                    SetProcessInterval(Uint32 ms);
         void                    PrimeProcessor();
         void                    SetAnimateProc(spriteProcPtr proc);
         void                    SetMoveProc(spriteProcPtr proc);
 
+        bool                    UsesTimers() const;
+        void                    ScheduleTimer(SS_Timer *t);
+        inline void             ScheduleTimers()        { ScheduleTimer(&moveTimer); ScheduleTimer(&animTimer); }
+        void                    RunTimer(SS_Timer *t);
+        inline Uint32           FirstDelay(Uint32 ms) const { return (Uint32)(((Uint64)ms * startPhase) >> 16); }
+
         virtual void            PushAndPrepareMatrix();                 // Set the matrix for this container
         inline void             RestoreMatrix() { glPopMatrix(); }      // Restore the old matrix
 
@@ -255,12 +276,18 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
 
         virtual void            BounceOff(SS_LayerItem * const base);
 
+        void                    SaveMotionState();
+        virtual void            BeginInterpolation(float alpha);
+        virtual void            EndInterpolation();
+
         virtual void            _Process();
         virtual void            Process();
+        virtual void            FinishParallel() {}
         void                    _Animate();
         virtual void            Animate();
         void                    Render() { Render(SS_WHITE_B); }
         virtual void            Render(const SScolorb &inTint);
+        virtual bool            Snapshot(SS_RenderSnapshot *snap, const SScolorb &inTint) { return false; }
 
         // Events and Commands
         virtual bool            HandleEvent(SDL_Event *e)       { return false; }
@@ -273,6 +300,13 @@ class SS_LayerItem : public SS_Broadcaster, public SS_Listener, public SS_RefCou
 
         static void             defaultAnimProc(SS_LayerItem *item);
 
+    protected:
+        void                    AddNode(SS_ItemNode *node);
+        void                    DropNode(SS_ItemNode *node);
+        SS_ItemNode*            NodeIn(const TLinkedList<SS_LayerItem*> *list) const;
+        void                    Unlist();
+        void                    CheckNodes() const;
+
     private:
         void                Init();
 };
@@ -0,0 +1,102 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Profiler.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_PROFILER_H__
+#define __SS_PROFILER_H__
+
+#include "SS_Types.h"
+
+#include <atomic>
+
+//
+// Stages of a world frame
+//
+enum profileStage {
+    SS_STAGE_INPUT,             // GetInput
+    SS_STAGE_EVENTS,            // HandleEvents
+    SS_STAGE_COLLISIONS,        // RunCollisionTest
+    SS_STAGE_PROCESS,           // Process
+    SS_STAGE_PHYSICS,           // AnimatePhysics
+    SS_STAGE_ANIMATE,           // Animate
+    SS_STAGE_RENDER,            // Render, not counting the swap
+    SS_STAGE_SWAP,              // SDL_GL_SwapWindow
+    SS_STAGE_COUNT
+};
+
+//--------------------------------------------------------------
+// SS_ProfileFrame
+// Stage times for one frame, in microseconds
+//
+struct SS_ProfileFrame
+{
+    Uint32              frame;                          // profiler frame number
+    Uint32              simFrame;                       // world sim frame at the end
+    Uint32              total;                          // whole frame, wall clock
+    Uint32              stage[SS_STAGE_COUNT];          // time in each stage
+    Uint16              layerCount;                     // layers rendered
+    Uint32              layer[SS_PROFILE_LAYERS];       // time in each layer's Render
+};
+
+//--------------------------------------------------------------
+// SS_Profiler
+//
+//  Times the stages of every frame of a world. Stages may be
+//  timed on the process thread or the render thread; their
+//  times are summed into atomics and collected by EndFrame,
+//  which is only called from the thread running the world.
+//
+//  Finished frames go into a ring buffer. There is only ever
+//  one writer, and each slot carries a sequence number, so
+//  any thread can read frames without taking a lock.
+//
+class SS_Profiler
+{
+    private:
+        struct Slot {
+            std::atomic<Uint32>     seq;                // odd while being written
+            SS_ProfileFrame         data;
+        };
+
+        Slot                        ring[SS_PROFILE_FRAMES];
+        std::atomic<Uint32>         written;            // frames written so far
+        std::atomic<Uint32>         accum[SS_STAGE_COUNT];  // stage time this frame
+        Uint32                      layerTime[SS_PROFILE_LAYERS];
+        Uint16                      layerCount;
+        Uint64                      frameStart;         // ns
+        bool                        enabled;
+
+    public:
+                                    SS_Profiler();
+
+        static inline Uint64        Now()                   { return SDL_GetTicksNS(); }
+        static inline Uint32        Since(Uint64 startNS)   { return (Uint32)((Now() - startNS) / 1000); }
+        static const char*          StageName(int s);
+
+        inline bool                 IsEnabled() const       { return enabled; }
+        inline void                 SetEnabled(bool e)      { enabled = e; }
+        inline Uint32               FrameCount() const      { return written.load(std::memory_order_acquire); }
+
+        // Recording
+        inline void                 AddStage(profileStage s, Uint64 startNS) {
+                                        if (enabled) accum[s].fetch_add(Since(startNS), std::memory_order_relaxed);
+                                    }
+        void                        AddLayer(Uint64 startNS);
+        void                        EndFrame(Uint32 simFrame);
+
+        // Queries
+        bool                        GetFrame(Uint32 back, SS_ProfileFrame *out) const;
+        Uint32                      GetAverage(Uint32 frames, SS_ProfileFrame *out) const;
+
+        // Overlay
+        static void                 StageColor(int s, SScolorb *color);
+        void                        Draw(float x, float y, float budgetMS=1000.0f/60) const;
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_RenderTarget.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_RENDERTARGET_H__
+#define __SS_RENDERTARGET_H__
+
+#include "SS_Types.h"
+
+#define SS_READBACK_BUFFERS 2
+
+//--------------------------------------------------------------
+// SS_RenderTarget
+// An offscreen framebuffer a world can render into, with
+// synchronous or double-buffered asynchronous RGBA readback.
+//
+
+class SS_RenderTarget
+{
+    private:
+        int             width, height;      // size in pixels
+        GLuint          fbo;                // framebuffer object (0 = window back buffer)
+        GLuint          colorBuffer;        // RGBA8 renderbuffer
+        GLuint          pbo[SS_READBACK_BUFFERS];       // pixel pack buffers for async readback
+        Uint8           *cpuBuffer[SS_READBACK_BUFFERS];// fallback when there are no PBOs
+        Uint32          bufferFrame[SS_READBACK_BUFFERS];   // frame tag of each capture
+        bool            bufferPending[SS_READBACK_BUFFERS]; // capture waiting to be read?
+        Uint16          nextBuffer;         // buffer the next Capture goes to
+        Uint32          dropped;            // captures overwritten before being read
+        GLint           savedViewport[4];   // viewport to restore in Unbind
+
+    public:
+                        SS_RenderTarget(int w, int h);
+                        ~SS_RenderTarget();
+
+        inline int      Width() const           { return width; }
+        inline int      Height() const          { return height; }
+        inline Uint32   PixelBytes() const      { return width * height * 4; }
+        inline bool     IsOffscreen() const     { return fbo != 0; }
+        inline Uint32   DroppedCaptures() const { return dropped; }
+
+        void            Bind();
+        void            Unbind();
+
+        void            ReadPixels(Uint8 *rgba);
+        void            Capture(Uint32 frame);
+        bool            GetPixels(Uint8 *rgba, Uint32 *frame=nullptr, bool wait=false);
+        bool            HasPendingCapture() const;
+
+    private:
+        void            Init(int w, int h);
+        void            Dispose();
+        void            BindForRead();
+        void            CopyFlipped(const Uint8 *src, Uint8 *dst);
+};
+
+#endif
@@ -264,6 +264,7 @@ class SS_TextLayer : public SS_Layer
 //      void                Process();
         void                Animate()  override{}
         void                Render() override;
+        bool                Snapshot(SS_RenderSnapshot *snap) override { return SnapshotLive(snap); }
 
     private:
         void                Init();
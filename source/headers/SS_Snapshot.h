@@ -0,0 +1,81 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Snapshot.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_SNAPSHOT_H__
+#define __SS_SNAPSHOT_H__
+
+#include "SS_Types.h"
+
+#include <SDL_thread.h>
+
+#include <vector>
+
+//--------------------------------------------------------------
+// SS_SnapItem
+// Everything needed to draw one frame-based item
+//
+struct SS_SnapItem
+{
+    SS_Frame            *frame;             // retained while in a snapshot
+    float               x, y, rot;          // draw position and rotation
+    float               xscale, yscale;     // draw scale
+    SScolorb            tint;               // combined item and layer tint
+};
+
+//--------------------------------------------------------------
+// SS_SnapLayer
+// A layer's projection and its run of items
+//
+struct SS_SnapLayer
+{
+    SS_Layer            *layer;             // the source layer
+    float               left, top;          // projection origin
+    float               width, height;      // projection size
+    Uint32              first, count;       // range in the item array
+    bool                live;               // can't be captured - Render the layer itself
+};
+
+//--------------------------------------------------------------
+// SS_RenderSnapshot
+//
+//  An immutable record of what the world looks like after a
+//  sim step. The sim thread builds one, publishes it, and
+//  the render thread draws it without touching the layers.
+//  Layers whose items can't be captured are marked live and
+//  drawn the old way, under the world lock.
+//
+class SS_RenderSnapshot
+{
+    private:
+        std::vector<SS_SnapLayer>   layers;
+        std::vector<SS_SnapItem>    items;
+        Uint32                      liveCount;      // layers needing the lock
+
+    public:
+        Uint32                      frame;          // sim frame this was taken on
+        SScolorf                    clearColor;
+
+                                    SS_RenderSnapshot();
+                                    ~SS_RenderSnapshot();
+
+        inline bool                 HasLiveLayers() const   { return liveCount != 0; }
+        inline Uint32               ItemCount() const       { return (Uint32)items.size(); }
+        inline Uint32               LayerCount() const      { return (Uint32)layers.size(); }
+
+        void                        Clear();
+        void                        BeginLayer(SS_Layer *layer);
+        void                        AddItem(SS_Frame *frame, float x, float y, float rot, float xs, float ys, const SScolorb &tint);
+        void                        DropLayerItems();
+        void                        EndLayer(bool live);
+
+        void                        Render(SS_World *world, SDL_mutex *liveMutex);
+};
+
+#endif
@@ -73,6 +73,7 @@ class SS_Sprite : public SS_Collider
 		inline SS_Frame*	Frame(Uint16 fr) { return frameArray[fr]; }
 
 		virtual void		Render(const SScolorb &inTint) override;
+		bool				Snapshot(SS_RenderSnapshot *snap, const SScolorb &inTint) override;
 
 		void				ReleaseFrames();
 
@@ -91,10 +92,12 @@ class SS_Sprite : public SS_Collider
 		// Collisions
 		bool				TestPointCollision(float x, float y, bool isLocal=false) override;
 		bool				_TestCollision(SS_Collider *other) override;
+		void				CollisionBounds(float *left, float *top, float *right, float *bottom) override;
 
 
 	private:
 		void				Init();
+		void				DrawPosition(float *outX, float *outY, float *outXS, float *outYS);
 };
 
 
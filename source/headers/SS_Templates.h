@@ -25,9 +25,13 @@
 #include "SS_macos_types.h"   // Carbon is gone; just need SInt16/UInt16 etc.
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 //#include <stdio.h>
 #include <SDL.h>
+#include <atomic>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 
 #include "SS_Config.h"   // provides SS_DEBUG + DEBUGF macro
@@ -51,7 +55,7 @@ class TArray
 {
 public:
     T           *m_array;
-    UInt16      m_count;
+    Uint32      m_count;
     UInt16      block_size;
 
     TArray()                        { Init(); }
@@ -65,12 +69,12 @@ public:
         block_size  = 10;
     }
 
-    inline UInt16   Size() const        { return m_count; }
+    inline Uint32   Size() const        { return m_count; }
     virtual inline void Clear()     { Resize(0); }
 
     inline void ZeroElements()      { if (m_count) memset(m_array, 0, m_count * sizeof(T)); }
 
-    inline void ZeroElements(UInt16 index, UInt16 size)
+    inline void ZeroElements(Uint32 index, Uint32 size)
     {
         if (index >= m_count)
             return;
@@ -84,13 +88,18 @@ public:
 
     //
     // Resize
+    // Grow or shrink to the given count, at the end or in front
     //
-    void Resize(UInt16 size, bool inFront=false, bool noZero=false)
+    void Resize(Uint32 size, bool inFront=false, bool noZero=false)
     {
+        SS_ASSERT(size <= (Uint32)INT32_MAX);
+
+        Sint32 delta = (Sint32)size - (Sint32)m_count;
+
         if (inFront)
-            ExpandOrContract(0, size, noZero);
+            ExpandOrContract(0, delta, noZero);
         else
-            ExpandOrContract(m_count - size, size, noZero);
+            ExpandOrContract(size < m_count ? size : m_count, delta, noZero);
     }
 
     //
@@ -105,21 +114,25 @@ public:
     // ExpandOrContract(0, 21);     Insert 21 elements before element 0
     // ExpandOrContract(12, 1);     Assuming m_count==12, adds one to the end
     //
-    virtual void ExpandOrContract(UInt16 index, SInt16 size, bool noZero=false)
+    virtual void ExpandOrContract(Uint32 index, Sint32 size, bool noZero=false)
     {
         if (size == 0) return;
 
+        // Debug builds catch a bad index and a count that would wrap
+        SS_ASSERT(index <= m_count);
+        SS_ASSERT(size > 0 ? (Uint32)size <= UINT32_MAX - m_count : (Uint32)-size <= m_count - index);
+
         if (size < 0)
-            MoveElements(index - size, index, m_count - index);
+            MoveElements(index - size, index, m_count - index + size);
 
-        UInt16 old_blocks = (m_count + block_size - 1) / block_size;
-        UInt16 new_blocks = (m_count + size + block_size - 1) / block_size;
+        Uint32 old_blocks = (m_count + block_size - 1) / block_size;
+        Uint32 new_blocks = (m_count + size + block_size - 1) / block_size;
 
         if (old_blocks != new_blocks)
         {
             if (m_array)
             {
-                if (size)
+                if (new_blocks)
                     m_array = (T*)realloc(m_array, sizeof(T) * new_blocks * block_size);
                 else
                 {
@@ -129,7 +142,7 @@ public:
             }
             else
             {
-                if (size)
+                if (new_blocks)
                 {
                     m_array = (T*)malloc(sizeof(T) * new_blocks * block_size);      // this trounces "front"
                 }
@@ -157,15 +170,15 @@ public:
     // In an Object Array the elements are pointers, which
     // are copied or moved without making new objects.
     //
-    inline void CopyElements(const T *src, T *dst, UInt16 size)     { if (src != dst) memmove(dst, src, size * sizeof(T)); }
-    inline void CopyElements(UInt16 src, T *dst, UInt16 size)       { CopyElements(&m_array[src], dst, size); }
-    inline void CopyElements(const T *src, UInt16 dst, UInt16 size) { CopyElements(src, &m_array[dst], size); }
-    inline void MoveElements(UInt16 src, UInt16 dst, UInt16 size)   { CopyElements(&m_array[src], &m_array[dst], size); }
+    inline void CopyElements(const T *src, T *dst, Uint32 size)     { if (src != dst) memmove(dst, src, size * sizeof(T)); }
+    inline void CopyElements(Uint32 src, T *dst, Uint32 size)       { CopyElements(&m_array[src], dst, size); }
+    inline void CopyElements(const T *src, Uint32 dst, Uint32 size) { CopyElements(src, &m_array[dst], size); }
+    inline void MoveElements(Uint32 src, Uint32 dst, Uint32 size)   { CopyElements(&m_array[src], &m_array[dst], size); }
 
     //
     // Element
     //
-    virtual T* Element(UInt16 index)
+    virtual T* Element(Uint32 index)
     {
         if (index < m_count)
             return &m_array[index];
@@ -183,25 +196,25 @@ public:
     // Append / Prepend / PopFirst / PopLast
     //
     virtual inline void Append(T& element)                  { InsertBefore(m_count, element); }
-    virtual inline void Append(T *element, UInt16 count=1)  { InsertBefore(m_count, element, count); }
+    virtual inline void Append(T *element, Uint32 count=1)  { InsertBefore(m_count, element, count); }
     virtual inline void Prepend(T& element)                 { InsertBefore(0, element); }
-    virtual inline void Prepend(T *element, UInt16 count=1) { InsertBefore(0, element, count); }
-    virtual inline void PopFirst(UInt16 count=1)            { Delete(0, count); }
-    virtual inline void PopLast(UInt16 count=1)             { Delete(m_count - count, count); }
-    virtual inline void Delete(UInt16 index, UInt16 count=1) { ExpandOrContract(index, -count); }
+    virtual inline void Prepend(T *element, Uint32 count=1) { InsertBefore(0, element, count); }
+    virtual inline void PopFirst(Uint32 count=1)            { Delete(0, count); }
+    virtual inline void PopLast(Uint32 count=1)             { Delete(m_count - count, count); }
+    virtual inline void Delete(Uint32 index, Uint32 count=1) { ExpandOrContract(index, -(Sint32)count); }
 
     //
     // InsertBefore / InsertAfter
     //
-    virtual void InsertBefore(UInt16 index, T *element, UInt16 count=1)
+    virtual void InsertBefore(Uint32 index, T *element, Uint32 count=1)
     {
         ExpandOrContract(index, count, true);
         CopyElements(element, &m_array[index], count);
     }
 
-    inline void InsertBefore(UInt16 index, T& element)                  { InsertBefore(index, &element); }
-    inline void InsertAfter(UInt16 index, T& element)                   { InsertBefore(index+1, &element); }
-    inline void InsertAfter(UInt16 index, T *element, UInt16 count=1)   { InsertBefore(index+1, element, count); }
+    inline void InsertBefore(Uint32 index, T& element)                  { InsertBefore(index, &element); }
+    inline void InsertAfter(Uint32 index, T& element)                   { InsertBefore(index+1, &element); }
+    inline void InsertAfter(Uint32 index, T *element, Uint32 count=1)   { InsertBefore(index+1, element, count); }
 
 
     //
@@ -248,7 +261,7 @@ public:
     //
     inline void Clear()                      override{ DisposeAll(); this->Resize(0); }
 
-    virtual void ExpandOrContract(UInt16 index, SInt16 size, bool noZero=false) override
+    virtual void ExpandOrContract(Uint32 index, Sint32 size, bool noZero=false) override
     {
         if (size < 0)
             DisposeMembers(index, index - size - 1);
@@ -259,16 +272,16 @@ public:
     //
     // ConstructMembers
     //
-    void ConstructMembers(UInt16 start, UInt16 end)
+    void ConstructMembers(Uint32 start, Uint32 end)
     {
-        for (int i=start; i<=end; i++)
+        for (Uint32 i=start; i<=end; i++)
             this->m_array[i] = new T;
     }
 
     //
     // DisposeMembers / DisposeAll
     //
-    void DisposeMembers(UInt16 start, UInt16 end)
+    void DisposeMembers(Uint32 start, Uint32 end)
     {
         if (start >= this->m_count)
             start = this->m_count - 1;
@@ -276,9 +289,9 @@ public:
         if (end >= this->m_count)
             end = this->m_count - 1;
 
-        if (start > end) { UInt16 s = start; start = end; end = s; }
+        if (start > end) { Uint32 s = start; start = end; end = s; }
 
-        for (int i=start; i<=end; i++)
+        for (Uint32 i=start; i<=end; i++)
         {
             if (this->m_array[i] != nullptr)
             {
@@ -298,13 +311,13 @@ public:
     //  Remember, every pointer is also an array.
     //  So this takes two pointers to arrays
     //
-    inline void ConstructCopies(T* src[], T* dst[], UInt16 size)
+    inline void ConstructCopies(T* src[], T* dst[], Uint32 size)
     {
         if (size)
         {
             if (dst >= src + size || src >= dst + size)
             {
-                for (int i=0; i<size; i++)
+                for (Uint32 i=0; i<size; i++)
                     dst[i] = new T(*src[i]);
             }
             else
@@ -317,7 +330,7 @@ public:
     // of the element, as in the TArray class.
     // . . . And yet the signature is the same. Hmmm . . .
     //
-    T* Object(UInt16 index)
+    T* Object(Uint32 index)
     {
         if (index < this->m_count)
             return this->m_array[index];
@@ -338,34 +351,34 @@ public:
     inline void AppendCopy(T& element)                                      { AppendCopy(&element); }
     inline void PrependCopy(T& element)                                     { PrependCopy(&element); }
 
-    inline void AppendCopy(T *element, UInt16 count=1)                      { InsertCopyBefore(this->m_count, element, count); }
-    inline void PrependCopy(T *element, UInt16 count=1)                     { InsertCopyBefore(0, element, count); }
+    inline void AppendCopy(T *element, Uint32 count=1)                      { InsertCopyBefore(this->m_count, element, count); }
+    inline void PrependCopy(T *element, Uint32 count=1)                     { InsertCopyBefore(0, element, count); }
 
-    virtual void InsertCopyBefore(UInt16 index, T** elemPtr, UInt16 count=1)
+    virtual void InsertCopyBefore(Uint32 index, T** elemPtr, Uint32 count=1)
     {
         ExpandOrContract(index, count, true);
         ConstructCopies(elemPtr, &this->m_array[index], count);
     }
 
-    inline void InsertCopyAfter(UInt16 index, T** elemPtr, UInt16 count=1)  { InsertCopyBefore(index+1, elemPtr, count); }
+    inline void InsertCopyAfter(Uint32 index, T** elemPtr, Uint32 count=1)  { InsertCopyBefore(index+1, elemPtr, count); }
 
-    inline void InsertCopyBefore(UInt16 index, T* element)                  { InsertCopyBefore(index, &element); }      // Calls list version
-    inline void InsertCopyAfter(UInt16 index, T* element)                   { InsertCopyBefore(index+1, &element); }    // address of an auto ok?
+    inline void InsertCopyBefore(Uint32 index, T* element)                  { InsertCopyBefore(index, &element); }      // Calls list version
+    inline void InsertCopyAfter(Uint32 index, T* element)                   { InsertCopyBefore(index+1, &element); }    // address of an auto ok?
 
-    inline void InsertCopyBefore(UInt16 index, T& elemRef)                  { InsertCopyBefore(index, &elemRef); }      // Calls pointer version
-    inline void InsertCopyAfter(UInt16 index, T& elemRef)                   { InsertCopyBefore(index+1, &elemRef); }    // address of a ref ok?
+    inline void InsertCopyBefore(Uint32 index, T& elemRef)                  { InsertCopyBefore(index, &elemRef); }      // Calls pointer version
+    inline void InsertCopyAfter(Uint32 index, T& elemRef)                   { InsertCopyBefore(index+1, &elemRef); }    // address of a ref ok?
 
     //
     // Delete / PopFirst / PopLast
     //
-    inline void Delete(UInt16 index, UInt16 count=1) override
+    inline void Delete(Uint32 index, Uint32 count=1) override
     {
         DisposeMembers(index, index+count-1);
-        ExpandOrContract(index, -count);
+        ExpandOrContract(index, -(Sint32)count);
     }
 
-    inline void PopFirst(UInt16 count=1)     override{ if (count < this->m_count) { Delete(0, count); } else Clear(); }
-    inline void PopLast(UInt16 count=1)      override{ if (count < this->m_count) { Delete(this->m_count-count, count); } else Clear(); }
+    inline void PopFirst(Uint32 count=1)     override{ if (count < this->m_count) { Delete(0, count); } else Clear(); }
+    inline void PopLast(Uint32 count=1)      override{ if (count < this->m_count) { Delete(this->m_count-count, count); } else Clear(); }
 
     //
     // operator=
@@ -388,6 +401,143 @@ public:
     }
 };
 
+#pragma mark -
+//
+// SS_NodeStats
+// Lifetime counts for the list node pools, over all threads
+//
+typedef struct {
+    Uint64      allocs, frees;          // nodes handed out and given back
+    Uint64      live, peak;             // nodes in use now, and at most
+    Uint64      slabs, bytes;           // slabs taken from the system
+} SS_NodeStats;
+
+//
+// SS_NodePool
+// The counters shared by all node pools
+//
+class SS_NodePool
+{
+protected:
+    static inline std::atomic<Uint64>   allocs{0}, frees{0}, live{0}, peak{0}, slabs{0}, bytes{0};
+
+    static inline void Carved(Uint64 b)
+    {
+        slabs.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(b, std::memory_order_relaxed);
+    }
+
+    static inline void Took()
+    {
+        allocs.fetch_add(1, std::memory_order_relaxed);
+
+        Uint64 now = live.fetch_add(1, std::memory_order_relaxed) + 1, top = peak.load(std::memory_order_relaxed);
+        while (now > top && !peak.compare_exchange_weak(top, now, std::memory_order_relaxed)) {}
+    }
+
+    static inline void Gave()
+    {
+        frees.fetch_add(1, std::memory_order_relaxed);
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+public:
+    static SS_NodeStats Stats()
+    {
+        SS_NodeStats st = {
+            allocs.load(std::memory_order_relaxed), frees.load(std::memory_order_relaxed),
+            live.load(std::memory_order_relaxed), peak.load(std::memory_order_relaxed),
+            slabs.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed)
+        };
+        return st;
+    }
+};
+
+//
+// TNodePool
+//
+//  A freelist of nodes of one size for each thread, filled
+//  a slab of SS_NODE_SLAB nodes at a time. Slabs are kept for
+//  the life of the program, so a node may be freed on any
+//  thread. When a thread ends its free nodes are left in a
+//  shared list for the next thread that runs dry.
+//
+template<size_t S>
+class TNodePool : public SS_NodePool
+{
+    static_assert(S >= sizeof(void*), "Nodes must hold a link");
+
+    struct FreeList {
+        void    *head = nullptr;
+
+        ~FreeList()
+        {
+            if (!head) return;
+
+            void *tail = head;
+            while (*(void**)tail) tail = *(void**)tail;
+
+            std::lock_guard<std::mutex> guard(lock);
+            *(void**)tail = orphans;
+            orphans = head;
+        }
+    };
+
+    static inline thread_local FreeList local;
+    static inline std::mutex            lock;
+    static inline void                  *orphans = nullptr;
+
+    //
+    // Refill
+    // Adopt the orphaned nodes, or carve up a new slab
+    //
+    static void Refill(FreeList &fl)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (orphans) {
+                fl.head = orphans;
+                orphans = nullptr;
+                return;
+            }
+        }
+
+        char *slab = (char*)malloc(S * SS_NODE_SLAB);
+        if (!slab) throw std::bad_alloc();
+
+        for (int i = 0; i < SS_NODE_SLAB - 1; i++)
+            *(void**)(slab + i * S) = slab + (i + 1) * S;
+
+        *(void**)(slab + (SS_NODE_SLAB - 1) * S) = nullptr;
+        fl.head = slab;
+
+        Carved(S * SS_NODE_SLAB);
+    }
+
+public:
+    static inline void* Take()
+    {
+        FreeList &fl = local;
+        if (!fl.head) Refill(fl);
+
+        void *node = fl.head;
+        fl.head = *(void**)node;
+
+        Took();
+        return node;
+    }
+
+    static inline void Give(void *node)
+    {
+        FreeList &fl = local;
+        *(void**)node = fl.head;
+        fl.head = node;
+
+        Gave();
+    }
+};
+
+
 #pragma mark -
 //
 // TListNode
@@ -404,6 +554,23 @@ public:
 
     virtual ~TListNode() {}
 
+#if SS_NODE_POOL
+    //
+    // operator new / delete
+    // Nodes come from the pool for their size
+    //
+    static void* operator new(size_t size)
+    {
+        SS_ASSERT(size == sizeof(TListNode<T>));
+        return TNodePool<sizeof(TListNode<T>)>::Take();
+    }
+
+    static void operator delete(void *node)
+    {
+        if (node) TNodePool<sizeof(TListNode<T>)>::Give(node);
+    }
+#endif
+
     //
     // Unlink
     // Remove a node from the list it is in
@@ -521,7 +688,14 @@ public:
 
     TListNode<T>*   m_head;
     TListNode<T>*   m_tail;
-    Uint16          m_count;
+    Uint32          m_count;
+
+    //
+    // CountUp / CountDown
+    // Debug builds catch a count that would wrap
+    //
+    inline void CountUp()       { SS_ASSERT(m_count < UINT32_MAX); m_count++; }
+    inline void CountDown()     { SS_ASSERT(m_count > 0); m_count--; }
 
     //
     // TLinkedList
@@ -592,7 +766,7 @@ public:
             m_head->m_prev = nullptr;
         }
 
-        m_count++;
+        CountUp();
         m_tail->m_container = this;
 
         return m_tail;
@@ -619,7 +793,7 @@ public:
             newnode->m_next = newnode->m_prev = nullptr;
         }
 
-        m_count++;
+        CountUp();
         newnode->m_container = this;
     }
 
@@ -646,7 +820,7 @@ public:
             m_head->m_next = nullptr;
             m_head->m_prev = nullptr;
         }
-        m_count++;
+        CountUp();
         m_head->m_container = this;
 
         return m_head;
@@ -674,7 +848,7 @@ public:
                 m_tail = m_tail->m_next;
 
             // increment the count
-            m_count++;
+            CountUp();
             newnode = p_iterator.m_node->m_next;
         }
         else
@@ -710,7 +884,7 @@ public:
                 m_head = m_head->m_prev;
 
             // increment the count
-            m_count++;
+            CountUp();
             newnode = node->m_prev;
         }
         else
@@ -752,7 +926,7 @@ public:
             else
                 m_tail = nullptr;
 
-            m_count--;
+            CountDown();
         }
     }
 
@@ -784,7 +958,7 @@ public:
             else
                 m_head = nullptr;
 
-            m_count--;
+            CountDown();
         }
     }
 
@@ -810,7 +984,7 @@ public:
         if (del)
             delete node;
 
-        m_count--;
+        CountDown();
     }
 
     //
@@ -974,7 +1148,7 @@ public:
     // Size
     // Return the size of the list
     //
-    Uint16 Size() const
+    Uint32 Size() const
     {
         return m_count;
     }
@@ -997,7 +1171,7 @@ public:
             return false;
 
         // write the size of the list first
-        fwrite( &m_count, sizeof( Uint16 ), 1, outfile );
+        fwrite( &m_count, sizeof( Uint32 ), 1, outfile );
 
         // now loop through and write the list.
         while ( itr ) {
@@ -1020,7 +1194,7 @@ public:
     {
         FILE*   infile = nullptr;
         T       buffer;
-        Uint16  count = 0;
+        Uint32  count = 0;
 
         // open the file
         infile = fopen( p_filename, "rb" );
@@ -1029,7 +1203,7 @@ public:
         if ( ! infile ) return false;
 
         // read the size of the list first
-        fread( &count, sizeof( Uint16 ), 1, infile );
+        fread( &count, sizeof( Uint32 ), 1, infile );
 
         // now loop through and read the list.
         while ( count ) {
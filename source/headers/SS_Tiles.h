@@ -105,8 +105,10 @@ class SS_TileLayer : public SS_Layer
         void        SetTileMap(SS_TileMap *map);
 
         void        Process() override;
+        bool        RunsItemTimers() const override { return false; }
         void        Animate() override;
         void        Render() override;
+        bool        Snapshot(SS_RenderSnapshot *snap) override { return SnapshotLive(snap); }
 
     private:
         void        Init(Uint32 f=SS_NONE);
@@ -0,0 +1,105 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Timers.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_TIMERS_H__
+#define __SS_TIMERS_H__
+
+#include "SS_Types.h"
+
+#include <vector>
+
+//
+// Wheel geometry: 256 one-millisecond slots, then three
+// levels of 64 slots, each slot as long as the level below.
+// That spans 2^26 ms (about 18 hours); anything further
+// out waits in the last level and is placed again later.
+//
+#define SS_WHEEL_NEAR_BITS  8
+#define SS_WHEEL_FAR_BITS   6
+#define SS_WHEEL_LEVELS     3
+
+#define SS_WHEEL_NEAR       (1 << SS_WHEEL_NEAR_BITS)
+#define SS_WHEEL_FAR        (1 << SS_WHEEL_FAR_BITS)
+
+//
+// What a timer fires
+//
+enum timerKind {
+    SS_TIMER_MOVE,                  // the item's Process
+    SS_TIMER_ANIMATE                // the item's Animate
+};
+
+//--------------------------------------------------------------
+// SS_Timer
+// One scheduled callback, embedded in its owner
+//
+struct SS_Timer
+{
+    SS_Timer            *prev, *next;       // links in a wheel slot
+    SS_Timer            **slot;             // the slot it's in, if any
+    SS_TimerWheel       *wheel;             // the wheel it's scheduled on
+    Sint32              firing;             // index in the fired list, or -1
+    Uint32              due;                // world time to fire
+    void                *owner;
+    Uint8               kind;
+
+                        SS_Timer()          { prev = next = nullptr; slot = nullptr; wheel = nullptr; firing = -1; due = 0; owner = nullptr; kind = 0; }
+                        SS_Timer(const SS_Timer&) = delete;
+    SS_Timer&           operator=(const SS_Timer&) = delete;
+
+    inline bool         IsScheduled() const { return wheel != nullptr; }
+};
+
+//--------------------------------------------------------------
+// SS_TimerWheel
+//
+//  A hierarchical timer wheel keyed on world time in ms.
+//  Scheduling and cancelling are O(1), and Advance only
+//  touches the slots it passes and the timers that are due,
+//  plus the occasional cascade of a slot from a higher level.
+//
+//  Advance returns the due timers in the order they fell due.
+//  They stay attached to the wheel while the caller works
+//  through them: rescheduling one puts it back, cancelling one
+//  (even one not reached yet) clears its entry in the list,
+//  and any left alone are dropped by the next Advance.
+//
+class SS_TimerWheel
+{
+    private:
+        SS_Timer                *nearSlots[SS_WHEEL_NEAR];
+        SS_Timer                *farSlots[SS_WHEEL_LEVELS][SS_WHEEL_FAR];
+        SS_Timer                *overdue;           // due before current
+        std::vector<SS_Timer*>  fired;
+        Uint32                  current;            // next ms to process
+        Uint32                  count;              // timers on the wheel
+
+    public:
+                                SS_TimerWheel();
+                                ~SS_TimerWheel();
+
+        inline Uint32           Count() const       { return count; }
+        inline Uint32           Time() const        { return current; }
+
+        void                    Schedule(SS_Timer *t, Uint32 due);
+        void                    Cancel(SS_Timer *t);
+        std::vector<SS_Timer*>& Advance(Uint32 now);
+
+    private:
+        void                    Link(SS_Timer **slot, SS_Timer *t);
+        void                    Detach(SS_Timer *t);
+        void                    Place(SS_Timer *t);
+        void                    Cascade(SS_Timer **slot);
+        void                    Fire(SS_Timer **slot);
+        SS_Timer*               TakeAll();
+        void                    DropFired();
+};
+
+#endif
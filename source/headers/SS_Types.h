@@ -42,6 +42,9 @@ class SS_Layer;
 class SS_LayerItem;
 class SS_Listener;
 class SS_RadioButton;
+class SS_Profiler;
+class SS_RenderSnapshot;
+class SS_RenderTarget;
 class SS_Scrollbar;
 class SS_SFont;
 class SS_Slider;
@@ -52,6 +55,7 @@ class SS_TextInput;
 class SS_TextLayer;
 class SS_TileLayer;
 class SS_TileMap;
+class SS_TimerWheel;
 class SS_World;
 
 
@@ -77,7 +81,9 @@ enum {
     SS_NOSCROLL = (1L << 1),
     SS_RADAR    = (1L << 2),
     SS_NOZOOM   = (1L << 3),
-    SS_ABSROT   = (1L << 4)
+    SS_ABSROT   = (1L << 4),
+    SS_INDEPENDENT = (1L << 5),     // layer touches no other layer during update
+    SS_PURE     = (1L << 6)         // item update has no side effects
 };
 
 //
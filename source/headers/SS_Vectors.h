@@ -155,7 +155,7 @@ class SS_VectorFrame : public SS_RefCounter
         SScolorb            lineTint;               // default line tint for new units
         SScolorb            fillTint;               // default fill tint for new units
         bool                useTint;                // whether or not to apply tint as we go
-        Sint16              begunUnit;              // the array being updated
+        Sint32              begunUnit;              // the array being updated
 
         GLuint              gl_texture;             // an OpenGL texture for this thing
         GLuint              gl_list;                // the stored display list
@@ -165,7 +165,7 @@ class SS_VectorFrame : public SS_RefCounter
         float               smallx, smally, largex, largey;
         float               xhandle, yhandle;       // handle offset from center
 
-                        SS_VectorFrame(GLfloat *vex, Uint16 len);
+                        SS_VectorFrame(GLfloat *vex, Uint32 len);
                         SS_VectorFrame(char *vectorFile);
                         SS_VectorFrame();
                         ~SS_VectorFrame();
@@ -187,13 +187,13 @@ class SS_VectorFrame : public SS_RefCounter
 
         void            PrependVector(float x, float y);
         void            AppendVector(float x, float y);
-        void            PrependVectorList(SSVectorType mode, ssVector *list, Uint16 size);
-        void            AppendVectorList(SSVectorType mode, ssVector *list, Uint16 size);
+        void            PrependVectorList(SSVectorType mode, ssVector *list, Uint32 size);
+        void            AppendVectorList(SSVectorType mode, ssVector *list, Uint32 size);
         void            PrependDuo(SSVectorType mode, float x1, float y1, float x2, float y2);
         void            AppendDuo(SSVectorType mode, float x1, float y1, float x2, float y2);
 
-        void            PopFirst(Uint16 count);
-        void            PopLast(Uint16 count);
+        void            PopFirst(Uint32 count);
+        void            PopLast(Uint32 count);
 
         inline void     AppendLine(float x1, float y1, float x2, float y2)      { AppendDuo(SS_LINES, x1, y1, x2, y2); }
         inline void     PrependLine(float x1, float y1, float x2, float y2)     { PrependDuo(SS_LINES, x1, y1, x2, y2); }
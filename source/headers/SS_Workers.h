@@ -0,0 +1,67 @@
+/*
+ *  OpenGL SimpleSprite Class Suite
+ *  (c) 2004 Scott Lahteine.
+ *
+ *  SS_Workers.h
+ *
+ *  $Id$
+ *
+ */
+
+#ifndef __SS_WORKERS_H__
+#define __SS_WORKERS_H__
+
+#include "SS_Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void (*workerProc)(void *data, Uint32 index);
+
+//--------------------------------------------------------------
+// SS_WorkerPool
+//
+//  A fixed set of threads that run parallel-for jobs. Run()
+//  hands out indices in chunks from a shared counter, so fast
+//  threads take more chunks than slow ones. The calling thread
+//  works too, and Run() returns only when every index is done.
+//
+//  A Run() from inside a job just runs serially, so nesting
+//  (e.g. parallel items inside parallel layers) can't deadlock.
+//
+class SS_WorkerPool
+{
+    private:
+        std::vector<std::thread>    threads;
+        std::mutex                  lock;
+        std::mutex                  runLock;            // one outside job at a time
+        std::condition_variable     wake, finished;
+
+        workerProc                  jobProc;            // the current job
+        void                        *jobData;
+        Uint32                      jobCount;           // number of indices
+        Uint32                      jobGrain;           // indices per chunk
+        std::atomic<Uint32>         jobNext;            // next index to hand out
+        Uint32                      jobSerial;          // bumped for each new job
+        int                         busy;               // workers still in the job
+        bool                        quit;
+
+    public:
+                                    SS_WorkerPool(int count=0);
+                                    ~SS_WorkerPool();
+
+        inline int                  ThreadCount() const     { return (int)threads.size(); }
+
+        void                        Run(Uint32 count, workerProc proc, void *data, Uint32 grain=1);
+
+        static SS_WorkerPool*       Shared();
+
+    private:
+        void                        WorkerLoop();
+        void                        RunChunks();
+};
+
+#endif
@@ -13,13 +13,21 @@
 
 #include "SS_ItemList.h"
 #include "SS_Collisions.h"
+#include "SS_FramePacer.h"
+#include "SS_FrameStats.h"
 #include "SS_Messages.h"
+#include "SS_Profiler.h"
+#include "SS_Timers.h"
 
 #include "SS_Types.h"
 
 #include <SDL_thread.h>
 #include <SDL.h>
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 class SS_Physics;
 
 // ---------------------------------------------------------------------------
@@ -43,8 +51,6 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
 
         SDL_Thread          *processThread, *renderThread;
         SDL_mutex           *worldMutex;
-        bool                calibrating;
-        Uint16              caliCount;
         worldEventProc      eventHandler;
         worldProc           preRenderProc;
         worldProc           postRenderProc;
@@ -62,6 +68,41 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
         Uint32              lastAutoTime;               // last time the auto fired
         Uint32              autoInterval;
 
+        Uint32              lastPhysTick;               // last time physics was stepped
+
+        // Fixed-timestep simulation clock
+        Uint32              simStep;                    // length of one sim step (ms), 0 = variable
+        Uint16              simMaxSteps;                // most sim steps to run per frame
+        Uint32              simTime;                    // the simulation clock (ms)
+        Uint32              simAccumulator;             // real time not yet simulated
+        Uint32              simLastTick;                // real time of the last accumulation
+        Uint32              simFrame;                   // number of sim steps run (starts at 1)
+        float               simAlpha;                   // fraction of a step left in the accumulator
+        bool                interpolate;                // interpolate items between sim states?
+
+        SS_RenderTarget     *renderTarget;              // offscreen target, if any
+        bool                captureFrames;              // read back every rendered frame?
+
+        // Pipelined rendering (triple-buffered snapshots)
+        bool                pipelined;                  // render from snapshots?
+        SS_RenderSnapshot   *snapshots[3];              // sim, ready, and render buffers
+        Uint16              simSnap, renderSnap;        // buffers owned by each side
+        std::atomic<int>    readySnap;                  // latest published buffer (| SS_SNAP_FRESH)
+
+        // Parallel layers
+        std::vector<SS_Layer*> parallelLayers;          // independent layers this pass
+        bool                deferNodes;                 // collision node updates wait for the join
+
+        SS_Profiler         profiler;                   // per-stage frame timing
+        SS_FrameStats       frameStats;                 // frame time histograms and hitches
+        std::string         statsFile;                  // where Run saves frameStats
+        SS_FramePacer       pacer;                      // vsync and throttling
+
+        // Item move and animate scheduling
+        SS_TimerWheel       timers;
+        std::vector<SS_Timer*> pureTimers[2];           // due SS_PURE timers, by kind
+        Uint32              swapTime;                   // last buffer swap (us)
+
     protected:
         SS_Game             *game;
 
@@ -70,9 +111,10 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
 
         float               left, top;
 
-        Uint16              slowCount;      // frame counting stuff
-        Uint32              frameCount;
+        Uint32              frameCount;     // frame counting stuff
         Uint32              fps;
+        Uint32              stepCount;      // sim steps since the last fps check
+        Uint32              sps;            // sim steps per second
 
         Uint32              ticks;          // adjusted world time
         Uint32              timeAdjust;     // adjustment factor
@@ -105,8 +147,23 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
         inline float        ViewHeight() const      { return view_h; }
         inline SS_LayerItem* MousePointer() const   { return pointerSprite; }
         inline bool         ProcessFlag() const     { return processFlag; }
-        inline Uint32       GetWorldTime() const    { return SDL_GetTicks() - timeAdjust; }
+        inline Uint32       GetWorldTime() const    { return simStep ? simTime : (Uint32)SDL_GetTicks() - timeAdjust; }
         inline bool         IsPaused() const        { return !processFlag; }
+        inline Uint32       FixedTimestep() const   { return simStep; }
+        inline bool         IsFixedStep() const     { return simStep != 0; }
+        inline Uint32       SimFrame() const        { return simFrame; }
+        inline bool         IsInterpolating() const { return simStep && interpolate; }
+        inline float        InterpolationAlpha() const { return simAlpha; }
+        inline SS_RenderTarget* RenderTarget() const    { return renderTarget; }
+        inline bool         IsPipelined() const     { return pipelined; }
+        inline bool         IsDeferringNodes() const { return deferNodes; }
+        inline void         SetDeferringNodes(bool d) { deferNodes = d; }
+        inline Uint32       FramesPerSecond() const { return fps; }
+        inline Uint32       StepsPerSecond() const  { return sps; }
+        inline SS_Profiler* Profiler()              { return &profiler; }
+        inline const SS_FrameStats* FrameStats() const { return &frameStats; }
+        inline SS_FramePacer* Pacer()               { return &pacer; }
+        inline SS_TimerWheel* Timers()              { return &timers; }
 
         // Setters
         inline void         SetLeftTop(float x, float y)        { left = x; top = y; }
@@ -122,6 +179,17 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
         void                Calibrate();
         void                SetSurface(SDL_Surface *s);
 
+        void                SetFixedTimestep(Uint32 ms, Uint16 maxSteps=5);
+        inline void         SetInterpolation(bool i)            { interpolate = i; }
+
+        void                SetRenderTarget(SS_RenderTarget *target, bool capture=true);
+        void                SetPipelined(bool p);
+
+        void                DrawProfileGraph(float x=8, float y=-1);
+        inline void         SetFrameBudget(Uint32 us)           { frameStats.SetBudget(us); }
+        inline void         SetFrameStatsFile(const char *path) { statsFile = path ? path : ""; }
+        void                WriteFrameStats();
+
         // Layer general methods
         inline void         LatchLayer(SS_Layer *l)             { latchedLayer = l; }
 
@@ -168,6 +236,8 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
         inline void         Quit() { worldQuit = true; }
 
         void                GetInput();
+        void                Simulate();
+        void                Step(float dt);
         void                Process();
         void                Animate();
         void                Render();
@@ -204,6 +274,14 @@ class SS_World : public SS_Broadcaster, public SS_Listener, public SS_LayerList,
 
     private:
         void                Init();
+        void                PublishSnapshot();
+        void                DrawSnapshot();
+        bool                GatherIndependentLayers();
+        void                RunTimers();
+
+        static void         process_layer(void *w, Uint32 i);
+        static void         run_timer(void *list, Uint32 i);
+        static void         animate_layer(void *w, Uint32 i);
 };
 
 #endif
@@ -35,7 +35,10 @@
 #include "SS_Layer.h"
 #include "SS_LayerItem.h"
 #include "SS_Messages.h"
+#include "SS_Profiler.h"
+#include "SS_RenderTarget.h"
 #include "SS_SFont.h"
+#include "SS_Snapshot.h"
 #include "SS_Sound.h"
 #include "SS_Sprite.h"
 #include "SS_Templates.h"
@@ -43,6 +46,7 @@
 #include "SS_Types.h"
 #include "SS_Utilities.h"
 #include "SS_Vectors.h"
+#include "SS_Workers.h"
 #include "SS_World.h"
 
 #endif